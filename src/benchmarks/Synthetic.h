@@ -0,0 +1,106 @@
+#ifndef PROJECT_SYNTHETIC_H
+#define PROJECT_SYNTHETIC_H
+
+#include "../source/dependencies.h"
+
+using namespace std;
+
+
+/**
+ * Parameters of a synthetic instance.
+ */
+struct Scenario {
+    string name;
+    int cVertices;
+    int cEdges;
+    int cPoints;
+
+    // Are the endpoints chosen by preferential attachment instead of uniformly?
+    bool powerLaw;
+
+    // Fraction of the points on a lattice, where many points are collinear
+    double collinear;
+};
+
+inline vector<Scenario> const SCENARIOS = {
+    {"sparse", 500, 1000, 1000, false, 0.0},
+    {"dense", 500, 5000, 1000, false, 0.0},
+    {"hubs", 1000, 3000, 2000, true, 0.0},
+    {"collinear", 500, 1500, 1000, false, 0.5},
+    {"grid", 500, 1500, 1000, false, 1.0}
+};
+
+
+/**
+ * Generates the points, vertices and edges of a scenario. Each vertex is located on the position of its own point.
+ * @param scenario The parameters.
+ * @param gen Random generator.
+ * @return The vertices, edges and points.
+ */
+inline tuple<vector<Vertex>, vector<Edge>, vector<Point>> generate(Scenario const &scenario, Xoshiro256 &gen) {
+    // Lattice and uniform points share the same square
+    int const side = static_cast<int>(ceil(sqrt(scenario.cPoints)));
+    int const step = 8;
+    int const extent = side * step;
+
+    vector<Point> points;
+    set<pair<int, int>> used;
+    auto const cLattice = static_cast<size_t>(scenario.collinear * scenario.cPoints);
+    while(points.size() < static_cast<size_t>(scenario.cPoints)) {
+        bool const onLattice = points.size() < cLattice;
+        int const x = onLattice ? static_cast<int>(gen.bounded(side)) * step : static_cast<int>(gen.bounded(extent));
+        int const y = onLattice ? static_cast<int>(gen.bounded(side)) * step : static_cast<int>(gen.bounded(extent));
+        if(used.emplace(x, y).second)
+            points.emplace_back(static_cast<int>(points.size()), x, y);
+    }
+
+    // Place the vertices on distinct random points
+    vector<int> order(points.size());
+    iota(order.begin(), order.end(), 0);
+    shuffle(order.begin(), order.end(), gen);
+
+    vector<Vertex> vertices;
+    for(int i=0; i<scenario.cVertices; i++)
+        vertices.emplace_back(i, points[order[i]].pos.x, points[order[i]].pos.y);
+
+    // Preferential attachment draws an endpoint of an existing edge, otherwise a uniform vertex
+    vector<int> endpoints;
+    set<pair<int, int>> existing;
+    vector<Edge> edges;
+    auto const draw = [&]() {
+        if(scenario.powerLaw && !endpoints.empty() && gen.bounded(2) == 0)
+            return endpoints[gen.bounded(endpoints.size())];
+        return static_cast<int>(gen.bounded(scenario.cVertices));
+    };
+
+    while(edges.size() < static_cast<size_t>(scenario.cEdges)) {
+        int const source = draw();
+        int const target = draw();
+        if(source == target || !existing.emplace(min(source, target), max(source, target)).second)
+            continue;
+
+        edges.emplace_back(static_cast<int>(edges.size()), vertices[source], vertices[target]);
+        endpoints.push_back(source);
+        endpoints.push_back(target);
+    }
+
+    return {vertices, edges, points};
+}
+
+/**
+ * Generates the PSE of a scenario by name. As in the given instances, the vertices do not occupy points yet.
+ * @param name Name of the scenario.
+ * @param seed Seed of the generator.
+ * @throws runtime_error if the scenario is unknown.
+ */
+inline PSE synthesize(string const &name, uint64_t const seed) {
+    auto const scenario = find_if(SCENARIOS.begin(), SCENARIOS.end(), [&](Scenario const &s) { return s.name == name; });
+    if(scenario == SCENARIOS.end())
+        throw runtime_error("Unknown scenario: " + name);
+
+    Xoshiro256 gen(seed);
+    auto [vertices, edges, points] = generate(*scenario, gen);
+    return {Drawing(vertices, edges), points, 1000000, 1000000};
+}
+
+#endif
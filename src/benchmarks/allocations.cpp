@@ -0,0 +1,114 @@
+#include "../source/dependencies.h"
+#include "../strategies/Registry.h"
+#include "Synthetic.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+
+/**
+ * Places each vertex on a distinct random point, which is faster than any placement strategy.
+ * @param emb The PSE with at least as many points as vertices.
+ */
+void place(PSE &emb) {
+    vector<int> order(emb.points.size());
+    iota(order.begin(), order.end(), 0);
+    shuffle(order.begin(), order.end(), Xoshiro256(1));
+    for (int vertexId=0; vertexId<static_cast<int>(emb.gamma.vertices.size()); vertexId++)
+        emb.moveToPoint(vertexId, order[vertexId]);
+}
+
+/**
+ * Runs SA with fixed seeds on a synthetic instance, whose iterations are probed by SimulatedAnnealing::run itself.
+ * @param emb The placed PSE.
+ * @param sequence The +-separated sequence of strategies.
+ * @param budget Time limit in minutes.
+ * @return Number of allocations within the probed iterations.
+ */
+long checkSequence(PSE const &emb, string const &sequence, double const budget) {
+    Executor exec("allocations", emb, InputOutput("", (fs::temp_directory_path() / "allocations").string()));
+    exec.maxTime = budget;
+    exec.reseed(1);
+
+    long const before = cProbedAllocations;
+    runSequence(exec, sequence);
+    return cProbedAllocations - before;
+}
+
+/**
+ * Applies random proposals by the kernels of the tracker as replay does, where each proposal is undone again.
+ * The scratch buffers are reserved and the tracker is prepared as in SimulatedAnnealing::run beforehand.
+ * @param emb The PSE, whose vertices occupy points.
+ * @param cProposals Number of proposals.
+ * @return Number of allocations within the proposals.
+ */
+long checkTrackedMoves(PSE emb, long const cProposals) {
+    size_t const maxDeg = static_cast<size_t>(emb.gamma.maxDeg);
+    ScratchArena::reserve(ScratchArena::adjacent, 2 * maxDeg);
+    emb.lazyScore();
+    PSE copy = emb;
+
+    Xoshiro256 gen(1);
+    auto const cVertices = static_cast<uint64_t>(emb.gamma.vertices.size());
+    auto const cPoints = static_cast<uint64_t>(emb.points.size());
+
+    long const before = cProbedAllocations;
+    {
+        AllocationProbe probe;
+        for (long i=0; i<cProposals; i++) {
+            int const vertexId = static_cast<int>(gen.bounded(cVertices));
+            int const pointId = static_cast<int>(gen.bounded(cPoints));
+            int const previous = emb.gamma.getVertex(vertexId).occupiedPoint;
+
+            long const delta = emb.deltaMoveOrSwap(vertexId, pointId);
+            emb.trackedMoveOrSwap(vertexId, pointId);
+            emb.trackedMoveOrSwap(vertexId, previous);
+            if (emb.boundedMoveOrSwap(vertexId, pointId, delta))
+                emb.fastCopy(copy);
+        }
+    }
+    return cProbedAllocations - before;
+}
+
+
+int main(int argc, char* argv[]) {
+    try {
+        cxxopts::Options options("allocations", "Fails if the probed hot loops allocate");
+        options.add_options()
+                ("g,generated", "Synthetic scenario", cxxopts::value<string>()->default_value("sparse"))
+                ("s,strategy", "Sequences of strategies, separated by ;",
+                        cxxopts::value<string>()->default_value("sa[walk];sa[rebuild];sa[hybrid];sa[candidates]"))
+                ("t,time", "Time limit per sequence in minutes", cxxopts::value<double>()->default_value("0.02"))
+                ("p,proposals", "Number of tracked proposals", cxxopts::value<long>()->default_value("1000"))
+                ("c,configPath", "Config directory", cxxopts::value<string>()->default_value("../config/"))
+                ("h,help", "Display help message");
+
+        auto input = options.parse(argc, argv);
+        if (input.count("help")) {
+            cout << options.help() << endl;
+            return 0;
+        }
+
+        Strategy::confDir = fs::absolute(input["configPath"].as<string>()).string() + "/";
+        Strategy::threads = 1;
+        PSE emb = synthesize(input["generated"].as<string>(), 42);
+        place(emb);
+
+        int cFailures = 0;
+        auto const report = [&cFailures](string const &workload, long const cCounted) {
+            cFailures += cCounted > 0;
+            cout << workload << ": " << cCounted << " allocations" << (cCounted > 0 ? " FAILED" : "") << endl;
+        };
+
+        for (string const &sequence : split(input["strategy"].as<string>(), ';'))
+            report(sequence, checkSequence(emb, sequence, input["time"].as<double>()));
+        report("tracked moves", checkTrackedMoves(emb, input["proposals"].as<long>()));
+
+        return cFailures > 0 ? 1 : 0;
+    }
+
+    catch (const cxxopts::exceptions::parsing &e) {
+        cerr << "Error parsing options: " << e.what() << endl;
+        return 1;
+    }
+}
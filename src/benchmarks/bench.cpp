@@ -0,0 +1,245 @@
+#include "../source/dependencies.h"
+#include "../strategies/Greedy.h"
+#include "Synthetic.h"
+
+using namespace std;
+using namespace chrono;
+namespace fs = std::filesystem;
+
+// Minimal measuring time per kernel in ns
+constexpr double MIN_NANOS = 2e8;
+
+// Prevents the compiler from discarding measured results
+volatile long sink = 0;
+
+
+/**
+ * Exposes the tracker internals of a PSE for the measurements.
+ */
+class ProbedPSE : public PSE {
+public:
+    explicit ProbedPSE(PSE const &emb) : PSE(emb) { }
+
+    long trackerPass() {
+        isTrackerReady = false;
+        prepareTracker();
+        return scoreTracker;
+    }
+
+    /**
+     * Subtracts and adds the penalty of a vertex, so the temperatures remain unchanged.
+     */
+    long penaltyPass(int const vertexId) {
+        return pen(vertexId, before) + pen(vertexId, after);
+    }
+};
+
+
+/**
+ * Measures the average runtime of a callable, which executes a batch of operations per call.
+ * @param cBatch Number of operations per call.
+ * @param callable The measured code.
+ * @return Nanoseconds per operation.
+ */
+template<typename Callable>
+double nanosPerOp(long const cBatch, Callable &&callable) {
+    long cCalls = 0;
+    double elapsed;
+    auto const start = steady_clock::now();
+    do {
+        callable();
+        cCalls += 1;
+        elapsed = duration<double, nano>(steady_clock::now() - start).count();
+    } while(elapsed < MIN_NANOS);
+
+    return elapsed / static_cast<double>(cCalls * cBatch);
+}
+
+
+/**
+ * Measures all kernels on a PSE whose vertices are located on points.
+ * @param emb The PSE.
+ * @param construct Creates the PSE again, e.g., from the instance's components.
+ * @param seed Seed for the random operations.
+ * @return Nanoseconds per operation for each kernel.
+ */
+template<typename Constructor>
+json measureKernels(PSE const &emb, Constructor &&construct, uint64_t const seed) {
+    json results;
+    Xoshiro256 gen(seed);
+    ProbedPSE probed(emb);
+    probed.lazyScore();
+
+    uint64_t const cVertices = probed.gamma.vertices.size();
+    uint64_t const cPoints = probed.points.size();
+
+    // Random segments between points, both as positions and coordinates
+    long constexpr cSegments = 1 << 12;
+    vector<Position> positions;
+    vector<Coordinate> coordinates;
+    for(long i=0; i<4*cSegments; i++) {
+        Position const &pos = probed.points[gen.bounded(cPoints)].pos;
+        positions.push_back(pos);
+        coordinates.push_back(VectorSpace::toCoordinate(pos));
+    }
+
+    int const penalty = static_cast<int>(probed.penalty);
+    results["evalSegments"] = nanosPerOp(cSegments, [&]() {
+        long sum = 0;
+        for(long i=0; i<4*cSegments; i+=4)
+            sum += VectorSpace::evalSegments(coordinates[i], coordinates[i + 1], coordinates[i + 2],
+                                             coordinates[i + 3], penalty);
+        sink = sink + sum;
+    });
+    results["evalSegments[double]"] = nanosPerOp(cSegments, [&]() {
+        long sum = 0;
+        for(long i=0; i<4*cSegments; i+=4)
+            sum += VectorSpace::evalSegments(positions[i], positions[i + 1], positions[i + 2],
+                                             positions[i + 3], penalty);
+        sink = sink + sum;
+    });
+
+    results["score"] = nanosPerOp(1, [&]() { sink = sink + probed.score(); });
+    results["prepareTracker"] = nanosPerOp(1, [&]() { sink = sink + probed.trackerPass(); });
+
+    long constexpr cBatch = 64;
+    results["pen"] = nanosPerOp(cBatch, [&]() {
+        for(long i=0; i<cBatch; i++)
+            sink = sink + probed.penaltyPass(static_cast<int>(gen.bounded(cVertices)));
+    }) / 2;
+
+    results["trackedMoveOrSwap"] = nanosPerOp(cBatch, [&]() {
+        for(long i=0; i<cBatch; i++) {
+            auto const vertexId = static_cast<int>(gen.bounded(cVertices));
+            auto const pointId = static_cast<int>(gen.bounded(cPoints));
+            probed.trackedMoveOrSwap(vertexId, pointId);
+        }
+    });
+
+    PSE copy = emb;
+    results["fastCopy"] = nanosPerOp(1, [&]() { copy.fastCopy(probed); });
+
+    results["construction"] = nanosPerOp(1, [&]() { sink = sink + construct().penalty; });
+    return results;
+}
+
+
+/**
+ * Measures the kernels on a synthetic instance.
+ */
+json measureScenario(Scenario const &scenario, uint64_t const seed) {
+    Xoshiro256 gen(seed);
+    auto const [vertices, edges, points] = generate(scenario, gen);
+
+    auto const construct = [&]() {
+        vector<Vertex> vertexCopy = vertices;
+        vector<Edge> edgeCopy = edges;
+        vector<Point> pointCopy = points;
+        return PSE(Drawing(vertexCopy, edgeCopy), pointCopy, 1000000, 1000000);
+    };
+
+    // Vertices on the position of a point do not yet occupy it
+    PSE emb = construct();
+    for(Vertex const &vertex : vertices)
+        emb.moveToPoint(vertex.id, emb.findPointOnPos(vertex.pos));
+    return measureKernels(emb, construct, seed);
+}
+
+
+/**
+ * Measures the kernels on a given instance after a greedy assignment.
+ * @param filePath Path to the instance.
+ * @param renumber Renumber the instance along a Hilbert curve.
+ */
+json measureInstance(fs::path const &filePath, bool const renumber, uint64_t const seed) {
+    InputOutput IO(filePath.parent_path().string(), fs::temp_directory_path().string(), renumber);
+    auto const construct = [&]() { return IO.load(filePath.filename().string()); };
+    return measureKernels(Greedy::fastAssignment(construct()), construct, seed);
+}
+
+
+/**
+ * Compares the results with a baseline and reports the kernels that are slower than the threshold permits.
+ * @return Number of regressions.
+ */
+int compare(json const &results, json const &baseline, double const threshold) {
+    int cRegressions = 0;
+    for(auto const &[scenario, kernels] : results.items()) {
+        if(!baseline.contains(scenario))
+            continue;
+
+        for(auto const &[kernel, nanos] : kernels.items()) {
+            if(!baseline[scenario].contains(kernel))
+                continue;
+
+            double const ratio = nanos.get<double>() / baseline[scenario][kernel].get<double>();
+            bool const regressed = ratio > 1 + threshold;
+            cRegressions += regressed;
+
+            cout << (regressed ? "REGRESSION " : "           ") << scenario << "/" << kernel
+                 << ": " << ratio << "x" << endl;
+        }
+    }
+    return cRegressions;
+}
+
+
+int main(int argc, char* argv[]) {
+    try {
+        cxxopts::Options options("bench", "Micro-benchmarks of the geometry and tracker kernels");
+        options.add_options()
+                ("i,instance", "Instances to be measured instead of the synthetic scenarios", cxxopts::value<vector<string>>())
+                ("r,renumber", "Additionally measure the instances in Hilbert order", cxxopts::value<bool>()->default_value("false"))
+                ("o,output", "File to store the results as JSON", cxxopts::value<string>())
+                ("b,baseline", "JSON results to compare with", cxxopts::value<string>())
+                ("threshold", "Tolerated slowdown against the baseline", cxxopts::value<double>()->default_value("0.1"))
+                ("seed", "Seed of the synthetic scenarios and operations", cxxopts::value<uint64_t>()->default_value("42"))
+                ("h,help", "Display help message");
+
+        auto input = options.parse(argc, argv);
+        if (input.count("help")) {
+            cout << options.help() << endl;
+            return 0;
+        }
+
+        uint64_t const seed = input["seed"].as<uint64_t>();
+
+        json results;
+        if (input.count("instance")) {
+            for (string const &path : input["instance"].as<vector<string>>()) {
+                fs::path const filePath = fs::absolute(path);
+                results[filePath.stem().string()] = measureInstance(filePath, false, seed);
+                if (input["renumber"].as<bool>())
+                    results[filePath.stem().string() + "[hilbert]"] = measureInstance(filePath, true, seed);
+            }
+        }
+        else for (Scenario const &scenario : SCENARIOS)
+            results[scenario.name] = measureScenario(scenario, seed);
+
+        cout << results.dump(4) << endl;
+
+        if (input.count("output")) {
+            ofstream file(input["output"].as<string>());
+            if (!file.is_open())
+                throw runtime_error("Output file cannot be opened.");
+            file << results.dump(4) << endl;
+        }
+
+        if (input.count("baseline")) {
+            ifstream file(input["baseline"].as<string>());
+            if (!file.is_open())
+                throw runtime_error("Baseline file is not existing.");
+
+            int const cRegressions = compare(results, json::parse(file), input["threshold"].as<double>());
+            cout << cRegressions << " regressions beyond the threshold." << endl;
+            return cRegressions > 0 ? 1 : 0;
+        }
+    }
+
+    catch (const cxxopts::exceptions::parsing &e) {
+        cerr << "Error parsing options: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,208 @@
+#include "../source/dependencies.h"
+#include "../strategies/Registry.h"
+#include "Synthetic.h"
+
+using namespace std;
+using namespace chrono;
+namespace fs = std::filesystem;
+
+
+/**
+ * Score-versus-time curve of a single run.
+ */
+struct Run {
+    string sequence;
+    int cThreads;
+    uint64_t seed;
+
+    // Saved scores with the consumed time in ms
+    vector<pair<long, long>> curve;
+};
+
+
+/**
+ * Runs a sequence of strategies on a copy of the PSE and records its curve.
+ * @param name Name of the instance.
+ * @param emb The initial PSE.
+ * @param sequence The +-separated sequence of strategies.
+ * @param budget Time limit in minutes.
+ */
+Run runOnce(string const &name, PSE const &emb, string const &sequence, int const cThreads,
+            uint64_t const seed, double const budget) {
+    fs::path const outputDir = fs::temp_directory_path() / "quality";
+    Strategy::threads = cThreads;
+
+    Executor exec(name, emb, InputOutput("", outputDir.string()));
+    exec.maxTime = budget;
+    exec.reseed(seed);
+    runSequence(exec, sequence);
+
+    return {sequence, cThreads, seed, exec.progress};
+}
+
+/**
+ * Determines the first time at which a curve reaches the target.
+ * @return Time in ms or -1 if the target is never reached.
+ */
+long timeToTarget(vector<pair<long, long>> const &curve, double const target) {
+    for(auto const &[time, score] : curve)
+        if(static_cast<double>(score) <= target)
+            return time;
+    return -1;
+}
+
+/**
+ * Integrates the score relative to the best score over the budget, divided by the budget. The curve holds its first
+ * score before the first save and its last score afterward, so 1 is the ideal value.
+ * @param curve The curve.
+ * @param best The best score of the instance.
+ * @param budget Time limit in ms.
+ */
+double areaUnderCurve(vector<pair<long, long>> const &curve, long const best, double const budget) {
+    if(curve.empty())
+        return numeric_limits<double>::infinity();
+
+    double const scale = static_cast<double>(max(best, 1L));
+    double area = 0;
+    for(size_t i=0; i<curve.size(); i++) {
+        double const from = i == 0 ? 0 : static_cast<double>(curve[i].first);
+        double const to = i + 1 < curve.size() ? static_cast<double>(curve[i + 1].first) : budget;
+        area += max(0.0, min(to, budget) - min(from, budget)) * static_cast<double>(curve[i].second) / scale;
+    }
+    return area / budget;
+}
+
+/**
+ * Prints the tables of an instance and converts its runs to JSON. Runs of the same sequence and thread count are
+ * summarized by the median time-to-target, where unreached targets count as infinite, and the mean area.
+ */
+json evaluate(string const &name, vector<Run> const &runs, vector<double> const &gaps, double const budget) {
+    long best = numeric_limits<long>::max();
+    for(Run const &run : runs)
+        for(auto const &[time, score] : run.curve)
+            best = min(best, score);
+
+    json result;
+    result["best"] = best;
+
+    cout << endl << "Instance " << name << " (best " << best << ")" << endl;
+    cout << left << setw(32) << "sequence" << setw(9) << "threads";
+    vector<string> labels;
+    for(double const gap : gaps) {
+        labels.push_back("ttt@" + to_string(static_cast<int>(round(gap * 100))) + "%");
+        cout << setw(12) << labels.back();
+    }
+    cout << "auc" << endl;
+
+    map<pair<string, int>, vector<Run const *>> groups;
+    for(Run const &run : runs)
+        groups[{run.sequence, run.cThreads}].push_back(&run);
+
+    for(auto const &[key, group] : groups) {
+        auto const &[sequence, cThreads] = key;
+        json summary = {{"sequence", sequence}, {"threads", cThreads}};
+        cout << left << setw(32) << sequence << setw(9) << cThreads;
+
+        for(size_t i=0; i<gaps.size(); i++) {
+            vector<long> times;
+            for(Run const *run : group) {
+                long const time = timeToTarget(run->curve, static_cast<double>(best) * (1 + gaps[i]));
+                times.push_back(time < 0 ? numeric_limits<long>::max() : time);
+            }
+            sort(times.begin(), times.end());
+            long const median = times[times.size() / 2];
+
+            string const &label = labels[i];
+            if(median == numeric_limits<long>::max()) {
+                summary[label] = nullptr;
+                cout << setw(12) << "-";
+            }
+            else {
+                summary[label] = median;
+                cout << setw(12) << (to_string(median) + "ms");
+            }
+        }
+
+        double auc = 0;
+        for(Run const *run : group)
+            auc += areaUnderCurve(run->curve, best, budget);
+        auc /= static_cast<double>(group.size());
+        summary["auc"] = auc;
+        cout << auc << endl;
+
+        result["summaries"].push_back(summary);
+    }
+
+    for(Run const &run : runs)
+        result["runs"].push_back({{"sequence", run.sequence}, {"threads", run.cThreads}, {"seed", run.seed},
+                                  {"curve", run.curve}});
+    return result;
+}
+
+
+int main(int argc, char* argv[]) {
+    try {
+        cxxopts::Options options("quality", "Time-to-target benchmark of strategy sequences");
+        options.add_options()
+                ("i,instance", "Bundled instances of the corpus", cxxopts::value<vector<string>>())
+                ("g,generated", "Synthetic scenarios of the corpus", cxxopts::value<vector<string>>()->default_value("sparse,collinear"))
+                ("s,strategy", "Sequences of strategies to be compared (;-separated)", cxxopts::value<string>()->default_value("greedy+sa[walk];greedy+sa[rebuild];greedy+sa[hybrid];fda[fr]+greedy+sa[walk]"))
+                ("t,time", "Time limit per run in minutes", cxxopts::value<double>()->default_value("0.25"))
+                ("seeds", "Seeds of the repeated runs", cxxopts::value<vector<uint64_t>>()->default_value("1,2"))
+                ("threads", "Thread counts of the parallel modes", cxxopts::value<vector<int>>()->default_value("1"))
+                ("gaps", "Targets as relative gaps to the best score", cxxopts::value<vector<double>>()->default_value("0.1,0.05,0.01"))
+                ("c,configPath", "Config directory", cxxopts::value<string>()->default_value("../config/"))
+                ("o,output", "File to store the curves and tables as JSON", cxxopts::value<string>())
+                ("h,help", "Display help message");
+
+        auto input = options.parse(argc, argv);
+        if (input.count("help")) {
+            cout << options.help() << endl;
+            return 0;
+        }
+
+        Strategy::confDir = fs::absolute(input["configPath"].as<string>()).string() + "/";
+        double const budget = input["time"].as<double>();
+        vector<string> const sequences = split(input["strategy"].as<string>(), ';');
+        vector<uint64_t> const seeds = input["seeds"].as<vector<uint64_t>>();
+        vector<int> const threadCounts = input["threads"].as<vector<int>>();
+        vector<double> const gaps = input["gaps"].as<vector<double>>();
+
+        // The corpus consists of generated and bundled instances
+        vector<pair<string, PSE>> corpus;
+        for (string const &scenario : input["generated"].as<vector<string>>())
+            corpus.emplace_back(scenario, synthesize(scenario, 42));
+        if (input.count("instance")) {
+            for (string const &path : input["instance"].as<vector<string>>()) {
+                fs::path const filePath = fs::absolute(path);
+                InputOutput IO(filePath.parent_path().string(), fs::temp_directory_path().string());
+                corpus.emplace_back(filePath.stem().string(), IO.load(filePath.filename().string()));
+            }
+        }
+
+        json results;
+        for (auto const &[name, emb] : corpus) {
+            vector<Run> runs;
+            for (string const &sequence : sequences)
+                for (int const cThreads : threadCounts)
+                    for (uint64_t const seed : seeds)
+                        runs.push_back(runOnce(name, emb, sequence, cThreads, seed, budget));
+
+            results[name] = evaluate(name, runs, gaps, budget * 60000);
+        }
+
+        if (input.count("output")) {
+            ofstream file(input["output"].as<string>());
+            if (!file.is_open())
+                throw runtime_error("Output file cannot be opened.");
+            file << results.dump(4) << endl;
+        }
+    }
+
+    catch (const cxxopts::exceptions::parsing &e) {
+        cerr << "Error parsing options: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
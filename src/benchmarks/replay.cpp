@@ -0,0 +1,126 @@
+#include "../source/dependencies.h"
+
+using namespace std;
+using namespace chrono;
+namespace fs = std::filesystem;
+
+
+/**
+ * Applies a proposal by tracked moves. A rejected proposal is undone by moving its vertices back in reverse order,
+ * since each moveOrSwap is reverted by a moveOrSwap to the vertex's previous point.
+ * @param emb The PSE.
+ * @param moves Vertices and target points.
+ * @param previous Buffer for the previous points.
+ * @param accepted Is the proposal accepted?
+ * @return Number of executed tracked moves.
+ */
+long replayProposal(PSE &emb, vector<pair<int, int>> const &moves, vector<int> &previous, bool const accepted) {
+    previous.clear();
+    for (auto const &[vertexId, pointId] : moves) {
+        previous.push_back(emb.gamma.getVertex(vertexId).occupiedPoint);
+        emb.trackedMoveOrSwap(vertexId, pointId);
+    }
+
+    if (accepted)
+        return static_cast<long>(moves.size());
+
+    for (long i=static_cast<long>(moves.size())-1; i>=0; i--)
+        emb.trackedMoveOrSwap(moves[i].first, previous[i]);
+    return 2 * static_cast<long>(moves.size());
+}
+
+
+int main(int argc, char* argv[]) {
+    try {
+        cxxopts::Options options("replay", "Replays a recorded move trace as benchmark of the tracked moves");
+        options.add_options()
+                ("i,instance", "Instance of the recording", cxxopts::value<string>())
+                ("m,moves", "Move trace recorded with --record", cxxopts::value<string>())
+                ("r,renumber", "Renumber the instance as in the recording", cxxopts::value<bool>()->default_value("false"))
+                ("h,help", "Display help message");
+
+        auto input = options.parse(argc, argv);
+        if (input.count("help") || !input.count("instance") || !input.count("moves")) {
+            cout << options.help() << endl;
+            return input.count("help") ? 0 : 1;
+        }
+
+        fs::path const filePath = fs::absolute(input["instance"].as<string>());
+        InputOutput IO(filePath.parent_path().string(), fs::temp_directory_path().string(), input["renumber"].as<bool>());
+        PSE const initial = IO.load(filePath.filename().string());
+
+        MoveReader reader(input["moves"].as<string>());
+
+        int cMismatches = 0;
+        int cSegments = 0;
+        PSE emb = initial;
+        PSE best = initial;
+        long bestScore = 0;
+
+        vector<pair<int, int>> moves;
+        vector<int> previous;
+        long cMoves = 0;
+        double secs = 0;
+        auto start = steady_clock::now();
+
+        while (reader.hasNext()) {
+            switch (reader.next()) {
+                case MoveReader::start: {
+                    // Each segment starts on the initial PSE with the recorded assignment
+                    emb = initial;
+                    vector<int> const assignment = reader.assignment();
+                    for (int vertexId=0; vertexId<static_cast<int>(assignment.size()); vertexId++)
+                        emb.moveToPoint(vertexId, assignment[vertexId]);
+                    bestScore = emb.lazyScore();
+                    best = emb;
+                    start = steady_clock::now();
+                    break;
+                }
+                case MoveReader::move: {
+                    auto const [vertexId, pointId, accepted, last] = reader.moveRecord();
+                    moves.emplace_back(vertexId, pointId);
+                    if (!last)
+                        break;
+
+                    cMoves += replayProposal(emb, moves, previous, accepted);
+                    moves.clear();
+
+                    if (accepted && emb.lazyScore() < bestScore) {
+                        bestScore = emb.lazyScore();
+                        best.fastCopy(emb);
+                    }
+                    break;
+                }
+                case MoveReader::restore:
+                    emb.fastCopy(best);
+                    break;
+                case MoveReader::end: {
+                    secs += duration<double>(steady_clock::now() - start).count();
+                    long const recorded = reader.score();
+                    long const tracked = emb.lazyScore();
+                    long const exact = emb.score();
+                    cSegments += 1;
+
+                    bool const matches = tracked == recorded && exact == recorded;
+                    cMismatches += !matches;
+                    cout << "Segment " << cSegments << ": recorded " << recorded << ", tracked " << tracked
+                         << ", exact " << exact << (matches ? "" : " MISMATCH") << endl;
+                    break;
+                }
+            }
+        }
+
+        cout << "Replayed " << cMoves << " tracked moves of " << cSegments << " segments in " << secs << "s" << endl;
+        cout << "moves/s = " << static_cast<double>(cMoves) / max(secs, 1e-9) << endl;
+        return cMismatches > 0 ? 1 : 0;
+    }
+
+    catch (const cxxopts::exceptions::parsing &e) {
+        cerr << "Error parsing options: " << e.what() << endl;
+        return 1;
+    }
+    catch (const runtime_error &e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+}
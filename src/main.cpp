@@ -1,47 +1,45 @@
 #include "source/dependencies.h"
 
-// TODO: Add all dependencies here!
-#include "strategies/Bruteforce.h"
-#include "strategies/ForceDirected.h"
-#include "strategies/Greedy.h"
-#include "strategies/SimulatedAnnealing.h"
-#include "strategies/Analysis.h"
+#include "strategies/Registry.h"
+#include "strategies/BatchServer.h"
 
 using namespace std;
 using namespace chrono;
 namespace fs = std::filesystem;
 
 void process(Executor &exec, const cxxopts::ParseResult& opt) {
-    exec.maxTime = opt["time"].as<int>();
-
-    // TODO: Add all supported strategies here!
-    unordered_map<string, function<unique_ptr<Strategy>()>> algos = {
-        {"bruteforce", []() { return make_unique<Bruteforce>(); }},
-        {"fda[fr]", []() { return make_unique<ForceDirected>(repelFR, attractFR, coolFR); }},
-        {"fda[spring]", []() { return make_unique<ForceDirected>(repelSpring, attractSpring, coolSpring); }},
-        {"greedy", []() { return make_unique<Greedy>(); }},
-        {"analysis", []() { return make_unique<Analysis>(); }},
-        {"sa[walk]", []() { return make_unique<SimulatedAnnealing>(randomWalk, coolExponential); }},
-        {"sa[rebuild]", []() { return make_unique<SimulatedAnnealing>(rebuildNeighbourhood, coolExponential); }},
-        {"sa[hybrid]", []() { return make_unique<SimulatedAnnealing>(hybrid, coolExponential); }},
-        // {"sa[walk,lin]", []() { return make_unique<SimulatedAnnealing>(randomWalk, coolLinear); }},
-        // {"sa[rebuild,lin]", []() { return make_unique<SimulatedAnnealing>(rebuildNeighbourhood, coolLinear); }},
-        // {"sa[hybrid,lin]", []() { return make_unique<SimulatedAnnealing>(hybrid, coolLinear); }},
-    };
-
-    string seq = opt["strategy"].as<std::string>();
-    transform(seq.begin(), seq.end(), seq.begin(), ::tolower);
-    vector<string> strategies = split(seq, '+');
-
-    for (string const &strategy : strategies) {
-        string trimmed = strategy;
-        auto it = algos.find(trimmed);
-        if (it != algos.end()) {
-            unique_ptr<Strategy> algo = it->second();
-            exec.run(*algo);
-        }
-        else throw runtime_error("Unimplemented strategy recognized.");
+    exec.maxTime = opt["time"].as<double>();
+    if (opt.count("seed"))
+        exec.reseed(opt["seed"].as<uint64_t>());
+    if (opt["trace"].as<long>() > 0)
+        exec.enableTrace(opt["trace"].as<long>());
+    if (opt["record"].as<bool>())
+        exec.enableRecording();
+
+    runSequence(exec, opt["strategy"].as<std::string>());
+}
+
+/**
+ * Runs the batch server on a local socket or on stdin. On stdin, the logs are redirected to stderr, so stdout only
+ * carries the result lines.
+ */
+void serve(const cxxopts::ParseResult& opt) {
+    int cWorkers = opt["workers"].as<int>();
+    if (cWorkers < 1)
+        cWorkers = static_cast<int>(max(1u, thread::hardware_concurrency()));
+
+    // The results and the redirection must outlive the workers of the server
+    ostream results(cout.rdbuf());
+    streambuf *const console = cout.rdbuf();
+    {
+        BatchServer server(cWorkers, opt["time"].as<double>(), opt["renumber"].as<bool>(), opt["cache"].as<int>());
+        if (opt.count("socket"))
+            server.serve(opt["socket"].as<string>());
+
+        cout.rdbuf(cerr.rdbuf());
+        server.serve(cin, make_shared<ResultSink>(results));
     }
+    cout.rdbuf(console);
 }
 
 int main(int argc, char* argv[]) {
@@ -53,7 +51,16 @@ int main(int argc, char* argv[]) {
                 ("c,configPath", "Config directory", cxxopts::value<string>()->default_value("../config/"))
                 ("s,strategy", "Sequence of strategies to be applied (+-seperated)", cxxopts::value<string>())
                 ("m,multiple", "Enable multiple file mode", cxxopts::value<bool>()->default_value("false"))
-                ("t,time", "Maximal time limit in minutes", cxxopts::value<int>()->default_value("50"))
+                ("t,time", "Maximal time limit in minutes", cxxopts::value<double>()->default_value("50"))
+                ("trace", "Interval in ms of the convergence trace, which is disabled by default", cxxopts::value<long>()->default_value("0"))
+                ("record", "Record the proposals as binary move trace for the replay benchmark", cxxopts::value<bool>()->default_value("false"))
+                ("threads", "Overrides the thread counts of all configurations", cxxopts::value<int>()->default_value("0"))
+                ("seed", "Seed for reproducible random values, also passed on to worker threads", cxxopts::value<uint64_t>())
+                ("r,renumber", "Renumber the instances along a Hilbert curve for cache locality", cxxopts::value<bool>()->default_value("false"))
+                ("serve", "Run JSON jobs from stdin, one per line, and write one JSON result per line", cxxopts::value<bool>()->default_value("false"))
+                ("socket", "Serve jobs on this local socket instead of stdin", cxxopts::value<string>())
+                ("workers", "Number of jobs served at once, all hardware threads by default", cxxopts::value<int>()->default_value("0"))
+                ("cache", "Number of instances the batch server keeps cached", cxxopts::value<int>()->default_value("16"))
                 ("h,help", "Display help message");
 
         auto input = options.parse(argc, argv);
@@ -63,19 +70,29 @@ int main(int argc, char* argv[]) {
             return 0;
         }
 
-        if (!input.count("inputPath") || !input.count("outputPath") || !input.count("strategy")) {
+        bool const serving = input["serve"].as<bool>() || input.count("socket");
+        if (!serving && (!input.count("inputPath") || !input.count("outputPath") || !input.count("strategy"))) {
             cout << options.help() << endl;
             return 1;
         }
 
+        auto pathConf = input["configPath"].as<string>();
+        Strategy::confDir = fs::absolute(pathConf).string();
+        Strategy::threads = input["threads"].as<int>();
+
+        if (serving) {
+            // Jobs name their own input and output paths
+            serve(input);
+            return 0;
+        }
+
         auto pathIn = input["inputPath"].as<string>();
         auto pathOut = input["outputPath"].as<string>();
-        auto pathConf = input["configPath"].as<string>();
         bool multipleFiles = input["multiple"].as<bool>();
+        bool renumber = input["renumber"].as<bool>();
 
         pathIn = fs::absolute(pathIn).string();
         pathOut = fs::absolute(pathOut).string();
-        Strategy::confDir = fs::absolute(pathConf).string();
 
         if (multipleFiles) {
             /**
@@ -83,7 +100,7 @@ int main(int argc, char* argv[]) {
              * The main-thread waits for all child-threads and tries to join them.
              */
 
-            InputOutput IO(pathIn, pathOut);
+            InputOutput IO(pathIn, pathOut, renumber);
 
             vector<fs::directory_entry> entries;
             for (const auto& entry : fs::directory_iterator(pathIn))
@@ -112,7 +129,7 @@ int main(int argc, char* argv[]) {
             fs::path filePath(pathIn);
             string fileName = filePath.filename().string();
             string fileDir = filePath.parent_path().string();
-            InputOutput IO(fileDir, pathOut);
+            InputOutput IO(fileDir, pathOut, renumber);
             Executor exec(fileName, IO);
             process(exec, input);
         }
@@ -0,0 +1,155 @@
+#ifndef PROJECT_ALLOCATIONS_H
+#define PROJECT_ALLOCATIONS_H
+
+#include "dependencies.h"
+
+using namespace std;
+
+
+// Global allocations of the current thread while a probe is counting
+inline thread_local long cAllocations = 0;
+inline thread_local bool isCountingAllocations = false;
+
+// Allocations within all finished probes of all threads
+inline atomic<long> cProbedAllocations = 0;
+
+#ifdef COUNT_ALLOCATIONS
+/**
+ * Counts and performs a global allocation. The replaced operators are not inlined, since the compiler would otherwise
+ * pair operator new with free at the call sites and warn about the mismatch.
+ * @param size Number of bytes.
+ * @param alignment Alignment or 0 for the default alignment of malloc.
+ * @return The memory or nullptr.
+ */
+[[gnu::noinline]] inline void *countedAllocation(size_t size, size_t const alignment) noexcept {
+    if(isCountingAllocations)
+        cAllocations += 1;
+    size = max<size_t>(size, 1);
+    if(alignment == 0)
+        return malloc(size);
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+/**
+ * Replaces all global allocations to count them. Like Strategy::run, these definitions rely on each executable
+ * consisting of a single translation unit.
+ */
+[[gnu::noinline]] void *operator new(size_t size) {
+    if(void *ptr = countedAllocation(size, 0))
+        return ptr;
+    throw bad_alloc();
+}
+
+[[gnu::noinline]] void *operator new[](size_t size) {
+    return operator new(size);
+}
+
+[[gnu::noinline]] void *operator new(size_t size, align_val_t alignment) {
+    if(void *ptr = countedAllocation(size, static_cast<size_t>(alignment)))
+        return ptr;
+    throw bad_alloc();
+}
+
+[[gnu::noinline]] void *operator new[](size_t size, align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+[[gnu::noinline]] void *operator new(size_t size, nothrow_t const &) noexcept {
+    return countedAllocation(size, 0);
+}
+
+[[gnu::noinline]] void *operator new[](size_t size, nothrow_t const &) noexcept {
+    return countedAllocation(size, 0);
+}
+
+[[gnu::noinline]] void *operator new(size_t size, align_val_t alignment, nothrow_t const &) noexcept {
+    return countedAllocation(size, static_cast<size_t>(alignment));
+}
+
+[[gnu::noinline]] void *operator new[](size_t size, align_val_t alignment, nothrow_t const &) noexcept {
+    return countedAllocation(size, static_cast<size_t>(alignment));
+}
+
+// Both malloc and aligned_alloc are released by free
+[[gnu::noinline]] void operator delete(void *ptr) noexcept { free(ptr); }
+[[gnu::noinline]] void operator delete[](void *ptr) noexcept { free(ptr); }
+[[gnu::noinline]] void operator delete(void *ptr, size_t) noexcept { free(ptr); }
+[[gnu::noinline]] void operator delete[](void *ptr, size_t) noexcept { free(ptr); }
+[[gnu::noinline]] void operator delete(void *ptr, align_val_t) noexcept { free(ptr); }
+[[gnu::noinline]] void operator delete[](void *ptr, align_val_t) noexcept { free(ptr); }
+[[gnu::noinline]] void operator delete(void *ptr, size_t, align_val_t) noexcept { free(ptr); }
+[[gnu::noinline]] void operator delete[](void *ptr, size_t, align_val_t) noexcept { free(ptr); }
+[[gnu::noinline]] void operator delete(void *ptr, nothrow_t const &) noexcept { free(ptr); }
+[[gnu::noinline]] void operator delete[](void *ptr, nothrow_t const &) noexcept { free(ptr); }
+[[gnu::noinline]] void operator delete(void *ptr, align_val_t, nothrow_t const &) noexcept { free(ptr); }
+[[gnu::noinline]] void operator delete[](void *ptr, align_val_t, nothrow_t const &) noexcept { free(ptr); }
+#endif
+
+
+/**
+ * Counts the allocations of a hot loop, which are added to cProbedAllocations once the probe ends. Only counts with
+ * the build option COUNT_ALLOCATIONS, where the allocations check fails on any of them. Otherwise, all counts are 0.
+ */
+class AllocationProbe {
+public:
+    AllocationProbe() {
+        cAllocations = 0;
+        isCountingAllocations = true;
+    }
+
+    ~AllocationProbe() {
+        isCountingAllocations = false;
+        cProbedAllocations += cAllocations;
+        cAllocations = 0;
+    }
+
+    AllocationProbe(AllocationProbe const &) = delete;
+    AllocationProbe &operator=(AllocationProbe const &) = delete;
+
+    /**
+     * Runs code whose allocations are permitted, e.g., saving interim results.
+     */
+    template<typename Callable>
+    void exempt(Callable &&callable) {
+        isCountingAllocations = false;
+        callable();
+        isCountingAllocations = true;
+    }
+};
+
+
+/**
+ * Per-thread buffers for the temporaries of hot loops. A buffer is cleared whenever it is taken, but keeps its
+ * capacity, so no allocations occur once the buffers are reserved or warmed up.
+ */
+class ScratchArena {
+public:
+    enum Slot {adjacent = 0, neighbours = 1, nearest = 2, partners = 3, candidates = 4, cSlots = 5};
+
+    /**
+     * Takes the cleared buffer of a slot. It remains valid until the thread takes the same slot again.
+     * @param slot The slot.
+     */
+    static vector<int> &take(Slot const slot) {
+        vector<int> &buffer = buffers()[slot];
+        buffer.clear();
+        return buffer;
+    }
+
+    /**
+     * Reserves the capacity of a slot for the current thread in advance.
+     * @param slot The slot.
+     * @param capacity Number of elements.
+     */
+    static void reserve(Slot const slot, size_t const capacity) {
+        buffers()[slot].reserve(capacity);
+    }
+
+private:
+    static array<vector<int>, cSlots> &buffers() {
+        thread_local array<vector<int>, cSlots> buffers;
+        return buffers;
+    }
+};
+
+#endif
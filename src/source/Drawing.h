@@ -14,12 +14,6 @@ struct Vertex {
     // Default is -1 and means not occupying
     int occupiedPoint = -1;
 
-    // Should the vertex be ignored during tracking?
-    bool ignored = false;
-
-    // Tracked temperature aka summed up penalties
-    long temp = 0;
-
     Vertex()
         : id(-1), pos({-1, -1}) { }
 
@@ -38,10 +32,6 @@ struct Vertex {
         // return json{{"id", id}, {"x", static_cast<int>(pos.x)}, {"y", static_cast<int>(pos.y)} };
     }
 
-    void moveToPos(Position const &position) {
-        pos = position;
-    }
-
     [[nodiscard]] bool isOccupying() const {
         return occupiedPoint > -1;
     }
@@ -84,35 +74,91 @@ struct Edge {
 };
 
 
+/**
+ * Immutable structure of a graph. It is shared among all copies of a drawing.
+ */
+struct Topology {
+    vector<Edge> edges;
+
+    // Endpoints per edge as structure of arrays for the crossing kernels
+    vector<int32_t> sources;
+    vector<int32_t> targets;
+
+    // Neighbours sorted by ID and the IDs of the corresponding edges
+    vector<vector<int>> adjacencyList;
+    vector<vector<int>> incidenceList;
+};
+
+
+/**
+ * Axis-aligned bounding box of a segment.
+ */
+struct Box {
+    double minX;
+    double maxX;
+    double minY;
+    double maxY;
+
+    template<typename Pos>
+    static Box around(Pos const &aPos, Pos const &bPos) {
+        return {static_cast<double>(min(aPos.x, bPos.x)), static_cast<double>(max(aPos.x, bPos.x)),
+                static_cast<double>(min(aPos.y, bPos.y)), static_cast<double>(max(aPos.y, bPos.y))};
+    }
+
+    [[nodiscard]] bool overlaps(Box const &other) const {
+        return (other.minX <= maxX) & (minX <= other.maxX) & (other.minY <= maxY) & (minY <= other.maxY);
+    }
+};
+
+
 class Drawing {
 public:
-    // Disclosure edges and vertices for simple foreach iterations
+    // Disclosure vertices for simple foreach iterations
     vector<Vertex> vertices;
-    vector<Edge> edges;
+
+    // Coordinates per vertex as structure of arrays for the crossing kernels
+    // Vertex::pos is a view that is kept in sync by moveToPos
+    vector<double> xs;
+    vector<double> ys;
+
+    // Exact coordinates per vertex, valid for vertices on the integer grid
+    vector<int64_t> gridXs;
+    vector<int64_t> gridYs;
+
+    // Axis-aligned bounding box per edge, kept in sync by moveToPos
+    // Edges can only cross or touch if their boxes overlap
+    vector<double> boxMinXs;
+    vector<double> boxMaxXs;
+    vector<double> boxMinYs;
+    vector<double> boxMaxYs;
+
+    // Tracked temperatures aka summed up penalties per vertex
+    vector<long> temps;
 
     // Max degree of a vertex
     long maxDeg = 0;
 
     Drawing()
-        : vertices({}), edges({}) { }
+        : vertices({}), topology(make_shared<Topology>()) { }
 
     /**
      * @param vertices The set of vertices.
      * @param edges The set of edges.
      */
     Drawing(vector<Vertex>& vertices, vector<Edge>& edges)
-            : vertices(vertices), edges(edges) {
-
-        // Initialize the adjacency matrix and list
-        adjacencyMatrix.resize(vertices.size());
-        for (auto const &aVertex : vertices) {
-            adjacencyMatrix[aVertex.id].resize(vertices.size());
-            for (auto const &bVertex : vertices)
-                adjacencyMatrix[aVertex.id][bVertex.id] = -1;
+            : vertices(vertices) {
+
+        auto shared = make_shared<Topology>();
+        shared->edges = edges;
+        for (auto const &edge : edges) {
+            shared->sources.push_back(edge.aVertexId);
+            shared->targets.push_back(edge.bVertexId);
         }
 
-        // Prepare the adjacency-lists, penalties, and -matrix
-        adjacencyList.resize(vertices.size());
+        temps.resize(vertices.size(), 0);
+
+        // Prepare the adjacency-lists and penalties
+        vector<vector<pair<int, int>>> adjacency(vertices.size());
         for (auto const &edge : edges) {
             Vertex &aVertex = getVertex(edge.aVertexId);
             Vertex &bVertex = getVertex(edge.bVertexId);
@@ -125,28 +171,119 @@ public:
             if (bVertex.deg > maxDeg)
                 maxDeg = bVertex.deg;
 
-            adjacencyMatrix[aVertex.id][bVertex.id] = edge.id;
-            adjacencyMatrix[bVertex.id][aVertex.id] = edge.id;
-            adjacencyList[aVertex.id].push_back(bVertex.id);
-            adjacencyList[bVertex.id].push_back(aVertex.id);
+            adjacency[aVertex.id].emplace_back(bVertex.id, edge.id);
+            adjacency[bVertex.id].emplace_back(aVertex.id, edge.id);
         }
 
+        // Sorted lists replace an adjacency matrix, which would need |V|^2 memory
+        shared->adjacencyList.resize(vertices.size());
+        shared->incidenceList.resize(vertices.size());
+        for (size_t vertexId=0; vertexId<adjacency.size(); vertexId++) {
+            sort(adjacency[vertexId].begin(), adjacency[vertexId].end());
+            for (auto const &[neighbourId, edgeId] : adjacency[vertexId]) {
+                shared->adjacencyList[vertexId].push_back(neighbourId);
+                shared->incidenceList[vertexId].push_back(edgeId);
+            }
+        }
+        topology = std::move(shared);
+
+        // Positions are initialized via moveToPos to keep all arrays in sync
+        xs.resize(vertices.size());
+        ys.resize(vertices.size());
+        gridXs.resize(vertices.size());
+        gridYs.resize(vertices.size());
+        offGrid.resize(vertices.size(), false);
+        boxMinXs.resize(edges.size());
+        boxMaxXs.resize(edges.size());
+        boxMinYs.resize(edges.size());
+        boxMaxYs.resize(edges.size());
+        for (auto const &vertex : this->vertices)
+            moveToPos(vertex.id, vertex.pos);
+
         // Initialize randomizer with uniform distribution
         randomVertex = NumRandomizer(0, static_cast<int>(vertices.size() - 1));
     }
 
+    /**
+     * Copies the positions, edge boxes and temperatures of a drawing of the same graph in O(|V| + |E|). Vertex::pos
+     * is a copy of xs and ys, which every move keeps in sync.
+     * @param other The other drawing.
+     */
+    void fastCopy(Drawing const &other) {
+        vertices = other.vertices;
+        xs = other.xs;
+        ys = other.ys;
+        gridXs = other.gridXs;
+        gridYs = other.gridYs;
+        offGrid = other.offGrid;
+        cOffGrid = other.cOffGrid;
+        boxMinXs = other.boxMinXs;
+        boxMaxXs = other.boxMaxXs;
+        boxMinYs = other.boxMinYs;
+        boxMaxYs = other.boxMaxYs;
+        temps = other.temps;
+    }
+
     Vertex &getVertex(int const &vertexId) {
         return vertices[vertexId];
     }
 
+    [[nodiscard]] Vertex const &getVertex(int const &vertexId) const {
+        return vertices[vertexId];
+    }
+
+    /**
+     * Moves a vertex to a specified position.
+     * @param vertexId ID of the vertex.
+     * @param pos Position in the plane.
+     */
+    void moveToPos(int const &vertexId, Position const &pos) {
+        vertices[vertexId].pos = pos;
+        xs[vertexId] = pos.x;
+        ys[vertexId] = pos.y;
+
+        // Count the vertices that prevent the exact predicates
+        bool const isOff = !VectorSpace::onGrid(pos);
+        if(isOff != offGrid[vertexId]) {
+            cOffGrid += isOff ? 1 : -1;
+            offGrid[vertexId] = isOff;
+        }
+        if(!isOff) {
+            gridXs[vertexId] = static_cast<int64_t>(pos.x);
+            gridYs[vertexId] = static_cast<int64_t>(pos.y);
+        }
+
+        for (int const edgeId : getIncidentEdges(vertexId))
+            updateBox(edgeId);
+    }
+
+    [[nodiscard]] Position posOf(int const &vertexId) const {
+        return {xs[vertexId], ys[vertexId]};
+    }
+
+    [[nodiscard]] Box boxOf(int const &edgeId) const {
+        return {boxMinXs[edgeId], boxMaxXs[edgeId], boxMinYs[edgeId], boxMaxYs[edgeId]};
+    }
+
+    [[nodiscard]] Coordinate coordinateOf(int const &vertexId) const {
+        return {gridXs[vertexId], gridYs[vertexId]};
+    }
+
+    /**
+     * Are all vertices on integral positions, e.g., on points? Otherwise, crossings must be evaluated by floating point.
+     */
+    [[nodiscard]] bool isOnGrid() const {
+        return cOffGrid == 0;
+    }
+
     Vertex &getRandomVertex(int const &exp) {
         // Uniform distributions has its own randomizer
         if(exp == 0)
             return getVertex(randomVertex.pull());
 
         long globTemp = 0;
-        for (auto &vertex : vertices)
-            globTemp += static_cast<long>(pow(vertex.temp, exp));
+        for (long const temp : temps)
+            globTemp += static_cast<long>(pow(temp, exp));
 
         // Generates zero division otherwise
         if (globTemp < 1)
@@ -156,7 +293,7 @@ public:
         long val = randomizer.pull();
 
         for (auto &vertex : vertices) {
-            val -= static_cast<long>(pow(vertex.temp, exp));
+            val -= static_cast<long>(pow(temps[vertex.id], exp));
             if (val < 0)
                 return vertex;
         }
@@ -165,16 +302,41 @@ public:
         return getRandomVertex(0);
     }
 
-    Edge &getEdge(int const &edgeId) {
-        return edges[edgeId];
+    [[nodiscard]] vector<Edge> const &edges() const {
+        return topology->edges;
     }
 
-    Edge &getEdge(int const &aVertexId, int const &bVertexId) {
-        return getEdge(adjacencyMatrix[aVertexId][bVertexId]);
+    [[nodiscard]] vector<int32_t> const &sources() const {
+        return topology->sources;
     }
 
-    vector<int> &getNeighbours(int const &vertexId) {
-        return adjacencyList[vertexId];
+    [[nodiscard]] vector<int32_t> const &targets() const {
+        return topology->targets;
+    }
+
+    [[nodiscard]] Edge const &getEdge(int const &edgeId) const {
+        return topology->edges[edgeId];
+    }
+
+    /**
+     * Retrieves the edge between two adjacent vertices.
+     * @param aVertexId ID of the vertex.
+     * @param bVertexId ID of the other vertex.
+     */
+    [[nodiscard]] Edge const &getEdge(int const &aVertexId, int const &bVertexId) const {
+        return getEdge(topology->incidenceList[aVertexId][neighbourIndex(aVertexId, bVertexId)]);
+    }
+
+    [[nodiscard]] vector<int> const &getNeighbours(int const &vertexId) const {
+        return topology->adjacencyList[vertexId];
+    }
+
+    /**
+     * Retrieves the IDs of a vertex's edges in the order of getNeighbours.
+     * @param vertexId ID of the vertex.
+     */
+    [[nodiscard]] vector<int> const &getIncidentEdges(int const &vertexId) const {
+        return topology->incidenceList[vertexId];
     }
 
     [[nodiscard]] bool existsVertex(int const &vertexId) const {
@@ -190,12 +352,33 @@ public:
         if(!existsVertex(aVertexId) || !existsVertex(bVertexId))
             return false;
 
-        return adjacencyMatrix[aVertexId][bVertexId] != -1;
+        vector<int> const &neighbours = getNeighbours(aVertexId);
+        return binary_search(neighbours.begin(), neighbours.end(), bVertexId);
     }
 
 protected:
-    vector<vector<int>> adjacencyMatrix;
-    vector<vector<int>> adjacencyList;
+    shared_ptr<Topology const> topology;
+
+    // Vertices that are not on the integer grid
+    vector<bool> offGrid;
+    long cOffGrid = 0;
+
+    void updateBox(int const &edgeId) {
+        int const source = topology->sources[edgeId];
+        int const target = topology->targets[edgeId];
+        boxMinXs[edgeId] = min(xs[source], xs[target]);
+        boxMaxXs[edgeId] = max(xs[source], xs[target]);
+        boxMinYs[edgeId] = min(ys[source], ys[target]);
+        boxMaxYs[edgeId] = max(ys[source], ys[target]);
+    }
+
+    /**
+     * Finds the position of a neighbour within the sorted adjacency list.
+     */
+    [[nodiscard]] long neighbourIndex(int const &aVertexId, int const &bVertexId) const {
+        vector<int> const &neighbours = getNeighbours(aVertexId);
+        return lower_bound(neighbours.begin(), neighbours.end(), bVertexId) - neighbours.begin();
+    }
 
     NumRandomizer<int> randomVertex;
 };
@@ -47,6 +47,151 @@ public:
 };
 
 
+/**
+ * Sampled estimate of a sum with the half width of its 95% confidence interval.
+ */
+struct Estimate {
+    double value = 0;
+    double halfWidth = 0;
+
+    /**
+     * Scales the mean of the samples to the sum over the population.
+     * @param sum Sum of the sampled values.
+     * @param squares Sum of their squares.
+     * @param cSamples Number of samples.
+     * @param population Number of values the samples are drawn from.
+     */
+    static Estimate fromSamples(double const sum, double const squares, long const cSamples, double const population) {
+        if(cSamples < 1)
+            return {};
+
+        auto const n = static_cast<double>(cSamples);
+        double const mean = sum / n;
+        double const variance = cSamples > 1 ? max(0.0, (squares - n * mean * mean) / (n - 1)) : 0;
+        return {mean * population, 1.96 * sqrt(variance / n) * population};
+    }
+};
+
+
+/**
+ * Uniform grid over a point set for nearest neighbour queries of arbitrary positions.
+ */
+class PointGrid {
+public:
+    PointGrid() = default;
+
+    /**
+     * @param points The point set.
+     */
+    explicit PointGrid(vector<Point> const &points) : positions(points.size()) {
+        if(points.empty())
+            return;
+
+        double minX = numeric_limits<double>::max(), minY = numeric_limits<double>::max();
+        double maxX = numeric_limits<double>::lowest(), maxY = numeric_limits<double>::lowest();
+        for(Point const &point : points) {
+            minX = min(minX, static_cast<double>(point.pos.x));
+            minY = min(minY, static_cast<double>(point.pos.y));
+            maxX = max(maxX, static_cast<double>(point.pos.x));
+            maxY = max(maxY, static_cast<double>(point.pos.y));
+        }
+
+        // About two points per cell
+        side = max(1, static_cast<int>(ceil(sqrt(static_cast<double>(points.size()) / 2))));
+        originX = minX;
+        originY = minY;
+        cellWidth = max(1.0, (maxX - minX) / side);
+        cellHeight = max(1.0, (maxY - minY) / side);
+
+        cells.resize(static_cast<size_t>(side) * side);
+        for(Point const &point : points) {
+            positions[point.id] = point.pos;
+            cells[cellOf(point.pos)].push_back(point.id);
+        }
+    }
+
+    /**
+     * Retrieves the n nearest points of a position, sorted by distance (or ID if same distance).
+     * @param pos The position.
+     * @param n Number to retrieve.
+     * @param nearest The buffer to be overwritten.
+     * @param excludedId ID of a point to skip, e.g., the point on the position.
+     */
+    void nearest(Position const &pos, int const n, vector<int> &nearest, int const excludedId = -1) const {
+        nearest.clear();
+        if(cells.empty() || n < 1)
+            return;
+
+        auto const [cx, cy] = cellCoordinates(pos);
+        vector<pair<double, int>> found;
+        for(int r=0; r<side; r++) {
+            // Visit the cells of the ring only, i.e., inner columns just at their top and bottom
+            for(int x=max(0, cx - r); x<=min(side - 1, cx + r); x++) {
+                int const step = abs(x - cx) == r ? 1 : max(1, 2 * r);
+                for(int y=cy - r; y<=cy + r; y+=step)
+                    if(y >= 0 && y < side)
+                        for(int const pointId : cells[static_cast<size_t>(x) * side + y])
+                            if(pointId != excludedId)
+                                found.emplace_back(VectorSpace::dist(pos, positions[pointId]), pointId);
+            }
+
+            // Points of further rings are at least r cells away, so equally distant points with lower IDs are missed
+            // only if the n-th distance reaches this bound
+            if(found.size() >= static_cast<size_t>(n)) {
+                nth_element(found.begin(), found.begin() + (n - 1), found.end());
+                if(found[n - 1].first < r * min(cellWidth, cellHeight))
+                    break;
+            }
+        }
+
+        auto const last = found.begin() + min(static_cast<long>(n), static_cast<long>(found.size()));
+        partial_sort(found.begin(), last, found.end());
+        for(auto it=found.begin(); it!=last; it++)
+            nearest.push_back(it->second);
+    }
+
+private:
+    int side = 1;
+    double originX = 0, originY = 0;
+    double cellWidth = 1, cellHeight = 1;
+
+    vector<Position> positions;
+    vector<vector<int>> cells;
+
+    [[nodiscard]] pair<int, int> cellCoordinates(Position const &pos) const {
+        int const x = clamp(static_cast<int>((static_cast<double>(pos.x) - originX) / cellWidth), 0, side - 1);
+        int const y = clamp(static_cast<int>((static_cast<double>(pos.y) - originY) / cellHeight), 0, side - 1);
+        return {x, y};
+    }
+
+    [[nodiscard]] size_t cellOf(Position const &pos) const {
+        auto const [x, y] = cellCoordinates(pos);
+        return static_cast<size_t>(x) * side + y;
+    }
+};
+
+
+/**
+ * Immutable lookup structures of a point set. They are shared among all copies of a PSE.
+ */
+struct PointIndex {
+    // Enables reverse access from coordinate to point
+    map<int, map<int, int>> coordinates;
+
+    // The maxDeg-nearest points per point
+    vector<vector<int>> milieu;
+
+    // Nearest neighbour queries of arbitrary positions
+    PointGrid grid;
+
+    // Is the point on a line through two other points?
+    vector<bool> collinear;
+
+    // Orientations of all point triples, only built for small point sets
+    OrientationTable orientations;
+};
+
+
 class PSE {
 public:
     int width = -1;
@@ -61,8 +206,11 @@ public:
     // Short-cut property for |E|
     long penalty = 0;
 
+    // Bound that is never exceeded by any score change
+    static constexpr long UNBOUNDED = numeric_limits<long>::max() / 4;
+
     PSE()
-        :  width(0), height(0), points({}) { }
+        :  width(0), height(0), points({}), index(make_shared<PointIndex>()) { }
 
     /**
      * @param drawing Drawing of graph G(V,E).
@@ -73,37 +221,50 @@ public:
     PSE(Drawing drawing, vector<Point> &points, int const width, int const height)
             : width(width), height(height), gamma(std::move(drawing)), points(points) {
 
-        milieu.resize(points.size());
-        for (auto &point : points) {
-            // Enables reverse access from coordinate to point
-            coordinates[static_cast<int>(point.pos.x)][static_cast<int>(point.pos.y)] = point.id;
-
-            // Create a queue of all other points, sorted by distance from the current point (or ID if same distance)
-            priority_queue<pair<double, int>, vector<pair<double, int>>, greater<>> queue;
-            for(auto const &otherPoint : points)
-                if(point != otherPoint)
-                    queue.emplace(VectorSpace::dist(point.pos, otherPoint.pos), otherPoint.id);
-
-            for(int i=0; i < gamma.maxDeg; i++) {
-                // Save the maxDeg-nearest points in a prepared list
-                milieu[point.id].emplace_back(queue.top().second);
-                queue.pop();
+        auto shared = make_shared<PointIndex>();
+        shared->milieu.resize(points.size());
+        shared->grid = PointGrid(points);
+        {
+            TELEMETRY_PHASE(milieu);
+            for (auto &point : points) {
+                // Enables reverse access from coordinate to point
+                shared->coordinates[static_cast<int>(point.pos.x)][static_cast<int>(point.pos.y)] = point.id;
+
+                // Save the maxDeg-nearest points (or lower IDs if same distance) in a prepared list
+                shared->grid.nearest(point.pos, static_cast<int>(gamma.maxDeg), shared->milieu[point.id], point.id);
             }
         }
+        shared->collinear = findCollinear(points);
+
+        vector<Coordinate> coordinates;
+        for (auto const &point : points)
+            coordinates.push_back(VectorSpace::toCoordinate(point.pos));
+        shared->orientations = OrientationTable(coordinates);
+
+        index = std::move(shared);
         penalty = static_cast<long>(gamma.vertices.size());
 
+        // Vertices of the input may already be located on points
+        anchors.resize(gamma.vertices.size(), -1);
+        genericWeights.resize(gamma.vertices.size(), OFF_POINT);
+        for (Vertex const &vertex : gamma.vertices)
+            anchor(vertex.id, findPointOnPos(vertex.pos));
+
         // Initialize randomizer with uniform distribution
         randomPoint = NumRandomizer(0, static_cast<int>(points.size() - 1));
     }
 
     /**
-     * Only copies dynamic values from another PSE.
+     * Only copies dynamic values from another PSE of the same instance, i.e., the points with their occupants, the
+     * drawing's positions, boxes and temperatures as well as the anchors. The copy thus costs O(|V| + |E| + |P|),
+     * although without allocations once the buffers are sized. Static data like topology and point index is shared.
      * @param other The PSE object to copy from.
      */
     void fastCopy(PSE const &other) {
         points = other.points;
-        gamma.vertices = other.gamma.vertices;
-        gamma.edges = other.gamma.edges;
+        gamma.fastCopy(other.gamma);
+        anchors = other.anchors;
+        genericWeights = other.genericWeights;
 
         scoreTracker = other.scoreTracker;
         isTrackerReady = other.isTrackerReady;
@@ -115,8 +276,8 @@ public:
      * @param pos Position in the plane.
      */
     void moveToPos(int const &vertexId, Position const &pos) {
-        Vertex &vertex = gamma.getVertex(vertexId);
-        vertex.moveToPos(pos);
+        gamma.moveToPos(vertexId, pos);
+        anchor(vertexId, -1);
     }
 
     /**
@@ -136,6 +297,7 @@ public:
         }
 
         moveToPos(vertex.id, point.pos);
+        anchor(vertex.id, point.id);
         vertex.occupiedPoint = pointId;
     }
 
@@ -149,6 +311,7 @@ public:
         Vertex &vertex = gamma.getVertex(vertexId);
         if(vertex.occupiedPoint == pointId)
             return;
+        TELEMETRY_COUNT(trackedMoves);
 
         long const oldScore = pen(vertex.id, TrackerMode::before);
         moveToPoint(vertex.id, pointId);
@@ -165,6 +328,7 @@ public:
     void ruthlessMoveToPoint(int const &vertexId, int const &pointId) {
         Point const &point = getPoint(pointId);
         moveToPos(vertexId, point.pos);
+        anchor(vertexId, point.id);
     }
 
     /**
@@ -174,6 +338,7 @@ public:
      */
     void trackedRuthlessMoveToPoint(int const &vertexId, int const &pointId) {
         prepareTracker();
+        TELEMETRY_COUNT(trackedMoves);
 
         long const oldScore = pen(vertexId, TrackerMode::before);
         ruthlessMoveToPoint(vertexId, pointId);
@@ -212,21 +377,20 @@ public:
         prepareTracker();
         if (aVertexId == bVertexId)
             return;
+        TELEMETRY_COUNT(trackedMoves);
 
-        Vertex const &aVertex = gamma.getVertex(aVertexId);
-        Vertex &bVertex = gamma.getVertex(bVertexId);
+        // The IDs may reference occupation states, which change during the exchange
+        int const aId = aVertexId;
+        int const bId = bVertexId;
 
-        bVertex.ignored = true;
-        long const aOldCrossings = pen(aVertex.id, TrackerMode::before);
-        bVertex.ignored = false;
-        long const bOldCrossings = pen(bVertex.id, TrackerMode::before);
+        // The shared edges are only counted for the second vertex
+        long const aOldCrossings = pen(aId, TrackerMode::before, bId);
+        long const bOldCrossings = pen(bId, TrackerMode::before);
 
-        exchangePoints(aVertexId, bVertexId);
+        exchangePoints(aId, bId);
 
-        bVertex.ignored = true;
-        long const aNewCrossings = pen(aVertex.id, TrackerMode::after);
-        bVertex.ignored = false;
-        long const bNewCrossings = pen(bVertex.id, TrackerMode::after);
+        long const aNewCrossings = pen(aId, TrackerMode::after, bId);
+        long const bNewCrossings = pen(bId, TrackerMode::after);
 
         // New version
         scoreTracker += (aNewCrossings - aOldCrossings);
@@ -259,6 +423,87 @@ public:
         else trackedMoveToPoint(vertexId, point.id);
     }
 
+    /**
+     * Calculates the score change of moving a vertex to a point without modifying the PSE.
+     * The occupation status of the target is not considered, analogous to trackedMoveToPoint.
+     * @param vertexId ID of the vertex.
+     * @param pointId ID of the target.
+     * @param maxDelta Bound for an early exit. Once exceeded, any value above the bound is returned.
+     */
+    [[nodiscard]] long deltaMove(int const &vertexId, int const &pointId, long const &maxDelta = UNBOUNDED) const {
+        Vertex const &vertex = gamma.getVertex(vertexId);
+        Point const &point = points[pointId];
+        if(vertex.pos == point.pos)
+            return 0;
+
+        // The new crossings only grow during the scan, so the old ones must be complete
+        long const oldScore = incidentCrossings(vertex.id, vertex.pos, genericWeights[vertex.id], -1, {}, OFF_POINT);
+        long const newScore = incidentCrossings(vertex.id, point.pos, weightOf(point.id), -1, {}, OFF_POINT, oldScore + maxDelta);
+        return newScore - oldScore;
+    }
+
+    /**
+     * Calculates the score change of exchanging the points of two vertices without modifying the PSE.
+     * @param aVertexId ID of the vertex.
+     * @param bVertexId ID of the other vertex.
+     * @param maxDelta Bound for an early exit. Once exceeded, any value above the bound is returned.
+     */
+    [[nodiscard]] long deltaSwap(int const &aVertexId, int const &bVertexId, long const &maxDelta = UNBOUNDED) const {
+        if(aVertexId == bVertexId)
+            return 0;
+
+        Vertex const &aVertex = gamma.getVertex(aVertexId);
+        Vertex const &bVertex = gamma.getVertex(bVertexId);
+
+        int8_t const aWeight = genericWeights[aVertex.id];
+        int8_t const bWeight = genericWeights[bVertex.id];
+        long const oldScore = incidentCrossings(aVertex.id, aVertex.pos, aWeight, bVertex.id, bVertex.pos, bWeight);
+        long const newScore = incidentCrossings(aVertex.id, bVertex.pos, bWeight, bVertex.id, aVertex.pos, aWeight, oldScore + maxDelta);
+        return newScore - oldScore;
+    }
+
+    /**
+     * Calculates the score change of moveOrSwap without modifying the PSE.
+     * @param vertexId ID of the vertex.
+     * @param pointId ID of the target.
+     * @param maxDelta Bound for an early exit. Once exceeded, any value above the bound is returned.
+     */
+    [[nodiscard]] long deltaMoveOrSwap(int const &vertexId, int const &pointId, long const &maxDelta = UNBOUNDED) const {
+        Point const &point = points[pointId];
+        if (point.isOccupied())
+            return deltaSwap(vertexId, point.occupierId, maxDelta);
+        return deltaMove(vertexId, point.id, maxDelta);
+    }
+
+    /**
+     * Executes moveOrSwap as tracked move if its score change does not exceed a bound.
+     * The evaluation stops as soon as the bound is exceeded and a rejected move leaves the PSE untouched.
+     * @param vertexId ID of the vertex.
+     * @param pointId ID of the target.
+     * @param maxDelta Maximal tolerated score change.
+     * @return Is the move executed?
+     */
+    bool boundedMoveOrSwap(int const &vertexId, int const &pointId, long const &maxDelta) {
+        if(deltaMoveOrSwap(vertexId, pointId, maxDelta) > maxDelta)
+            return false;
+
+        trackedMoveOrSwap(vertexId, pointId);
+        return true;
+    }
+
+    /**
+     * Executes moveOrSwap and adds an already known score change to the tracker.
+     * Local temperatures are not updated, since this would require the single crossings.
+     * @param vertexId ID of the vertex.
+     * @param pointId ID of the target.
+     * @param delta Score change, usually determined by deltaMoveOrSwap.
+     */
+    void apply(int const &vertexId, int const &pointId, long const &delta) {
+        prepareTracker();
+        moveOrSwap(vertexId, pointId);
+        scoreTracker += delta;
+    }
+
     Point &getPoint(int const &pointId) {
         return points[pointId];
     }
@@ -268,7 +513,38 @@ public:
     }
 
     Point &getPointOnPos(Position const &pos) {
-        return getPoint(coordinates[static_cast<int>(pos.x)][static_cast<int>(pos.y)]);
+        return getPoint(index->coordinates.at(static_cast<int>(pos.x)).at(static_cast<int>(pos.y)));
+    }
+
+    /**
+     * Is the point on a line through two other points? Only such points can cause penalties for vertices on edges.
+     * @param pointId ID of the point.
+     */
+    [[nodiscard]] bool isCollinear(int const &pointId) const {
+        return index->collinear[pointId];
+    }
+
+    /**
+     * Retrieves the table of point orientations, which is disabled for large point sets.
+     */
+    [[nodiscard]] OrientationTable const &getOrientations() const {
+        return index->orientations;
+    }
+
+    /**
+     * Looks up the point on a given position without modifying the coordinate index.
+     * @param pos Position in the plane.
+     * @return ID of the point or -1 if no point is located there.
+     */
+    [[nodiscard]] int findPointOnPos(Position const &pos) const {
+        auto const column = index->coordinates.find(static_cast<int>(pos.x));
+        if(column == index->coordinates.end())
+            return -1;
+
+        auto const row = column->second.find(static_cast<int>(pos.y));
+        if(row == column->second.end() || points[row->second].pos != pos)
+            return -1;
+        return row->second;
     }
 
     /**
@@ -277,25 +553,37 @@ public:
      * @param n Number to retrieve.
      */
     vector<int> nNearestPoints(int const &pointId, int const &n) {
-        // Try to use the cached nearest points first
-        if(n <= gamma.maxDeg)
-            return {milieu[pointId].begin(), milieu[pointId].begin() + n};
-
-        // Create a queue of all other points, sorted by distance from the considered point (or ID if same distance)
-        Point const &point = getPoint(pointId);
-        priority_queue<pair<double, int>, vector<pair<double, int>>, greater<>> queue;
-        for(Point &otherPoint : points)
-            if(point != otherPoint)
-                queue.emplace(VectorSpace::dist(point.pos, otherPoint.pos), otherPoint.id);
-
-        // Store n-nearest points in a vector
         vector<int> nearest;
-        for(int i=0; i<n; i++) {
-            nearest.emplace_back(queue.top().second);
-            queue.pop();
+        nNearestPoints(pointId, n, nearest);
+        return nearest;
+    }
+
+    /**
+     * Retrieves the n nearest points into a buffer, which does not allocate for cached points.
+     * @param pointId ID of the target.
+     * @param n Number to retrieve.
+     * @param nearest The buffer to be overwritten.
+     */
+    void nNearestPoints(int const &pointId, int const &n, vector<int> &nearest) {
+        // Try to use the cached nearest points first
+        if(n <= gamma.maxDeg) {
+            vector<int> const &milieu = index->milieu[pointId];
+            nearest.assign(milieu.begin(), milieu.begin() + n);
+            return;
         }
 
-        return nearest;
+        // Otherwise, query the grid of all other points
+        index->grid.nearest(getPoint(pointId).pos, n, nearest, pointId);
+    }
+
+    /**
+     * Retrieves the n nearest points of an arbitrary position, sorted by distance (or ID if same distance).
+     * @param pos The position.
+     * @param n Number to retrieve.
+     * @param nearest The buffer to be overwritten.
+     */
+    void nearestPoints(Position const &pos, int const &n, vector<int> &nearest) const {
+        index->grid.nearest(pos, n, nearest);
     }
 
     /**
@@ -306,9 +594,12 @@ public:
         long crossings = 0;
 
         // Sum all penalties of all edges (without duplications)
-        for (auto aEdge = gamma.edges.begin(); aEdge != gamma.edges.end(); ++aEdge)
-            for (auto bEdge = next(aEdge); bEdge != gamma.edges.end(); ++bEdge)
-                crossings += cross(*aEdge, *bEdge);
+        int const cEdges = static_cast<int>(gamma.sources().size());
+        for (int aEdgeId=0; aEdgeId<cEdges; aEdgeId++)
+            forOverlapping(gamma.boxOf(aEdgeId), aEdgeId + 1, cEdges, [&](long const bEdgeId) {
+                crossings += cross(aEdgeId, static_cast<int>(bEdgeId));
+                return true;
+            });
 
         return crossings;
     }
@@ -324,11 +615,83 @@ public:
         return scoreTracker;
     }
 
+    /**
+     * Estimates the total score by uniformly drawn pairs of distinct edges.
+     * @param cSamples Number of drawn pairs.
+     */
+    [[nodiscard]] Estimate estimateScore(long const cSamples) const {
+        auto const cEdges = static_cast<long>(gamma.sources().size());
+        if(cEdges < 2)
+            return {};
+
+        Xoshiro256 &gen = threadGenerator();
+        double sum = 0, squares = 0;
+        for(long i=0; i<cSamples; i++) {
+            auto const aEdgeId = static_cast<long>(gen.bounded(static_cast<uint64_t>(cEdges)));
+            auto bEdgeId = static_cast<long>(gen.bounded(static_cast<uint64_t>(cEdges - 1)));
+            bEdgeId += bEdgeId >= aEdgeId;
+
+            auto const pen = static_cast<double>(cross(static_cast<int>(aEdgeId), static_cast<int>(bEdgeId)));
+            sum += pen;
+            squares += pen * pen;
+        }
+
+        return Estimate::fromSamples(sum, squares, cSamples, static_cast<double>(cEdges * (cEdges - 1) / 2));
+    }
+
+    /**
+     * Draws uniform edges as partners of sampled penalties. Sampling several placements against the same partners
+     * keeps the difference of their estimates precise.
+     * @param cSamples Number of drawn edges.
+     * @param partners Buffer for the IDs of the edges.
+     */
+    void drawPartners(long const cSamples, vector<int> &partners) const {
+        auto const cEdges = static_cast<uint64_t>(gamma.sources().size());
+        Xoshiro256 &gen = threadGenerator();
+        partners.clear();
+        for(long i=0; i<cSamples && cEdges > 0; i++)
+            partners.push_back(static_cast<int>(gen.bounded(cEdges)));
+    }
+
+    /**
+     * Estimates the penalty on a vertex's adjacent edges from sampled partner edges.
+     * @param vertexId ID of the vertex.
+     * @param partners IDs of uniformly drawn edges.
+     * @param skippedId ID of a vertex, whose edge to the vertex is skipped, since it was sampled along with that vertex.
+     */
+    [[nodiscard]] Estimate samplePen(int const &vertexId, vector<int> const &partners, int const skippedId = -1) const {
+        vector<int> const &incident = gamma.getIncidentEdges(vertexId);
+        int32_t const *sources = gamma.sources().data();
+        int32_t const *targets = gamma.targets().data();
+        double sum = 0, squares = 0;
+        for(int const bEdgeId : partners) {
+            long pen = 0;
+            for(int const aEdgeId : incident)
+                if(aEdgeId != bEdgeId && sources[aEdgeId] != skippedId && targets[aEdgeId] != skippedId)
+                    pen += cross(aEdgeId, bEdgeId);
+
+            sum += static_cast<double>(pen);
+            squares += static_cast<double>(pen) * static_cast<double>(pen);
+        }
+
+        auto const cPartners = static_cast<long>(partners.size());
+        return Estimate::fromSamples(sum, squares, cPartners, static_cast<double>(gamma.sources().size()));
+    }
+
+    /**
+     * Invalidates the tracked score and local temperatures, e.g., after untracked modifications.
+     * The tracker is prepared again at the next call of lazyScore.
+     */
+    void resetTracker() {
+        isTrackerReady = false;
+        fill(gamma.temps.begin(), gamma.temps.end(), 0);
+    }
+
 protected:
     NumRandomizer<int> randomPoint;
 
-    map<int, map<int, int>> coordinates;
-    vector<vector<int>> milieu;
+    // Static data shared among all copies
+    shared_ptr<PointIndex const> index;
 
     // Currently tracked score
     long scoreTracker = 0;
@@ -336,20 +699,256 @@ protected:
     // Is the tracker initialized?
     bool isTrackerReady = false;
 
+    // Point per vertex if it is placed on one, otherwise -1
+    vector<int32_t> anchors;
+
+    // Weight of a vertex's position, i.e., GENERIC on a point that is not collinear with two other points, 0 on other
+    // points and OFF_POINT elsewhere. Stored as bytes, since the kernels read these weights for every edge pair
+    vector<int8_t> genericWeights;
+    static constexpr int8_t GENERIC = 1;
+    static constexpr int8_t OFF_POINT = -4;
+
+    /**
+     * Records the point a vertex is placed on.
+     * @param vertexId ID of the vertex.
+     * @param pointId ID of the point or -1 for other positions.
+     */
+    void anchor(int const &vertexId, int const &pointId) {
+        anchors[vertexId] = pointId;
+        genericWeights[vertexId] = weightOf(pointId);
+    }
+
+    /**
+     * @param pointId ID of the point or -1 for other positions.
+     * @return Weight of a vertex placed on the point.
+     */
+    [[nodiscard]] int8_t weightOf(int const pointId) const {
+        if(pointId == -1)
+            return OFF_POINT;
+        return index->collinear[pointId] ? 0 : GENERIC;
+    }
+
+    /**
+     * Every triple of two segments' endpoints misses only one endpoint. Thus, no triple is collinear if all endpoints
+     * are on points and at least two of them are generic. Other positions may lie on any line, which their weight
+     * excludes, since one of them keeps the sum below 2.
+     * @param cWeight Sum of the endpoints' weights.
+     */
+    static bool isNonCollinear(int const cWeight) {
+        return cWeight >= 2;
+    }
+
+    /**
+     * Detects the points that are on a line through two other points. The directions to all other points are
+     * normalized by their gcd, so equal directions reveal collinear triples exactly.
+     * @param points The point set.
+     */
+    static vector<bool> findCollinear(vector<Point> const &points) {
+        int const cPoints = static_cast<int>(points.size());
+        vector<char> collinear(cPoints, false);
+
+        auto const analyze = [&](int const first, int const step) {
+            vector<pair<int64_t, int64_t>> directions;
+            for(int i=first; i<cPoints; i+=step) {
+                Coordinate const pos = VectorSpace::toCoordinate(points[i].pos);
+
+                directions.clear();
+                for(int j=0; j<cPoints; j++) {
+                    if(i == j)
+                        continue;
+
+                    Coordinate const other = VectorSpace::toCoordinate(points[j].pos);
+                    int64_t dx = other.x - pos.x;
+                    int64_t dy = other.y - pos.y;
+                    int64_t const divisor = max<int64_t>(1, gcd(dx, dy));
+                    dx /= divisor;
+                    dy /= divisor;
+
+                    // Opposite directions are on the same line
+                    if(dx < 0 || (dx == 0 && dy < 0)) {
+                        dx = -dx;
+                        dy = -dy;
+                    }
+                    directions.emplace_back(dx, dy);
+                }
+
+                // Duplicated points are collinear with every other point
+                sort(directions.begin(), directions.end());
+                bool const duplicate = !directions.empty() && directions.front() == pair<int64_t, int64_t>{0, 0};
+                collinear[i] = duplicate || adjacent_find(directions.begin(), directions.end()) != directions.end();
+            }
+        };
+
+        int const cThreads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+        vector<thread> workers;
+        for(int t=0; t<cThreads; t++)
+            workers.emplace_back(analyze, t, cThreads);
+        for(auto &worker : workers)
+            worker.join();
+
+        return {collinear.begin(), collinear.end()};
+    }
+
     /**
      * Evaluates a cross for two edges.
-     * @param aEdge The first edge.
-     * @param bEdge The second edge.
-     */
-    long cross(Edge const &aEdge, Edge const &bEdge) {
-        if(aEdge != bEdge){
-            Position const &aStart = gamma.getVertex(aEdge.aVertexId).pos;
-            Position const &aEnd = gamma.getVertex(aEdge.bVertexId).pos;
-            Position const &bStart = gamma.getVertex(bEdge.aVertexId).pos;
-            Position const &bEnd = gamma.getVertex(bEdge.bVertexId).pos;
-            return VectorSpace::evalSegments(aStart, aEnd, bStart, bEnd, penalty);
+     * @param aEdgeId ID of the first edge.
+     * @param bEdgeId ID of the second edge.
+     */
+    [[nodiscard]] long cross(int const aEdgeId, int const bEdgeId) const {
+        vector<int32_t> const &sources = gamma.sources();
+        vector<int32_t> const &targets = gamma.targets();
+        bool const nonCollinear = isNonCollinear(genericWeights[sources[aEdgeId]] + genericWeights[targets[aEdgeId]] +
+                                                 genericWeights[sources[bEdgeId]] + genericWeights[targets[bEdgeId]]);
+
+        // Edges between four distinct points are mostly decided by the orientation table
+        OrientationTable const &orientations = index->orientations;
+        if(orientations.isEnabled()) {
+            int const aStart = anchors[sources[aEdgeId]];
+            int const aEnd = anchors[targets[aEdgeId]];
+            int const bStart = anchors[sources[bEdgeId]];
+            int const bEnd = anchors[targets[bEdgeId]];
+            bool const distinct = aStart != aEnd && aStart != bStart && aStart != bEnd &&
+                                  aEnd != bStart && aEnd != bEnd && bStart != bEnd;
+            if(distinct && min({aStart, aEnd, bStart, bEnd}) != -1) {
+                int const decided = orientations.cross(aStart, aEnd, bStart, bEnd);
+                if(decided != -1) {
+                    TELEMETRY_COUNT(crossByTable);
+                    return decided;
+                }
+            }
         }
-        return 0;
+
+        // Exact predicates as long as no vertex is placed continuously
+        if(gamma.isOnGrid()) {
+            TELEMETRY_COUNT(crossOnGrid);
+            return VectorSpace::evalSegments(gamma.coordinateOf(sources[aEdgeId]), gamma.coordinateOf(targets[aEdgeId]),
+                                             gamma.coordinateOf(sources[bEdgeId]), gamma.coordinateOf(targets[bEdgeId]), penalty, nonCollinear);
+        }
+
+        TELEMETRY_COUNT(crossContinuous);
+        return VectorSpace::evalSegments(gamma.posOf(sources[aEdgeId]), gamma.posOf(targets[aEdgeId]),
+                                         gamma.posOf(sources[bEdgeId]), gamma.posOf(targets[bEdgeId]), penalty, nonCollinear);
+    }
+
+    /**
+     * Visits the edges within [first, last) whose boxes overlap the given box. All other edges can neither cross nor
+     * touch the box's segment. The overlap test is branch-free over blocks of 64 edges, so it can be vectorised.
+     * @param box Bounding box of the segment.
+     * @param first ID of the first edge.
+     * @param last ID after the last edge.
+     * @param visit Called per overlapping edge. Returning false stops the scan.
+     */
+    template<typename Visitor>
+    void forOverlapping(Box const &box, long const first, long const last, Visitor &&visit) const {
+        double const *minXs = gamma.boxMinXs.data();
+        double const *maxXs = gamma.boxMaxXs.data();
+        double const *minYs = gamma.boxMinYs.data();
+        double const *maxYs = gamma.boxMaxYs.data();
+
+        for (long block=first; block<last; block+=64) {
+            int const cBlock = static_cast<int>(min(64L, last - block));
+
+            uint64_t mask = 0;
+            for (int i=0; i<cBlock; i++) {
+                long const edgeId = block + i;
+                bool const overlaps = box.overlaps({minXs[edgeId], maxXs[edgeId], minYs[edgeId], maxYs[edgeId]});
+                mask |= static_cast<uint64_t>(overlaps) << i;
+            }
+
+            while (mask != 0) {
+                long const edgeId = block + __builtin_ctzll(mask);
+                mask &= mask - 1;
+                if(!visit(edgeId))
+                    return;
+            }
+        }
+    }
+
+    /**
+     * Sums the penalties of all edge pairs that contain an edge adjacent to one of two relocated vertices.
+     * All other vertices remain on their current positions.
+     * @param aVertexId ID of the relocated vertex.
+     * @param aPos Assumed position of the relocated vertex.
+     * @param aWeight Weight of the assumed position as in genericWeights.
+     * @param bVertexId ID of the other relocated vertex or -1.
+     * @param bPos Assumed position of the other relocated vertex.
+     * @param bWeight Weight of the other assumed position.
+     * @param limit The scan stops as soon as the sum exceeds the limit.
+     */
+    [[nodiscard]] long incidentCrossings(int const aVertexId, Position const &aPos, int8_t const aWeight,
+                                         int const bVertexId, Position const &bPos, int8_t const bWeight,
+                                         long const limit = UNBOUNDED) const {
+        bool const exact = gamma.isOnGrid() && VectorSpace::onGrid(aPos) && (bVertexId == -1 || VectorSpace::onGrid(bPos));
+        if(exact)
+            return incidentCrossings(aVertexId, VectorSpace::toCoordinate(aPos), aWeight, bVertexId, VectorSpace::toCoordinate(bPos), bWeight,
+                                     gamma.gridXs.data(), gamma.gridYs.data(), limit);
+        return incidentCrossings(aVertexId, aPos, aWeight, bVertexId, bPos, bWeight, gamma.xs.data(), gamma.ys.data(), limit);
+    }
+
+    /**
+     * Scan of incidentCrossings on either exact or continuous coordinates.
+     */
+    template<typename Pos, typename Num>
+    [[nodiscard]] long incidentCrossings(int const aVertexId, Pos const &aPos, int8_t const aWeight,
+                                         int const bVertexId, Pos const &bPos, int8_t const bWeight,
+                                         Num const *xs, Num const *ys, long const limit) const {
+        int32_t const *sources = gamma.sources().data();
+        int32_t const *targets = gamma.targets().data();
+        long const cEdges = static_cast<long>(gamma.sources().size());
+
+        auto const posOf = [&](int const vertexId) -> Pos {
+            if(vertexId == aVertexId)
+                return aPos;
+            if(vertexId == bVertexId)
+                return bPos;
+            return {xs[vertexId], ys[vertexId]};
+        };
+        auto const weightAt = [&](int const vertexId) -> int {
+            if(vertexId == aVertexId)
+                return aWeight;
+            if(vertexId == bVertexId)
+                return bWeight;
+            return genericWeights[vertexId];
+        };
+
+        // Collect the adjacent edges without duplicating a shared edge
+        vector<int> &adjacent = ScratchArena::take(ScratchArena::adjacent);
+        vector<int> const &incident = gamma.getIncidentEdges(aVertexId);
+        adjacent.assign(incident.begin(), incident.end());
+        if(bVertexId != -1)
+            for (int const edgeId : gamma.getIncidentEdges(bVertexId))
+                if(sources[edgeId] != aVertexId && targets[edgeId] != aVertexId)
+                    adjacent.push_back(edgeId);
+
+        long score = 0;
+        for (size_t i=0; i<adjacent.size(); i++) {
+            Pos const aStart = posOf(sources[adjacent[i]]);
+            Pos const aEnd = posOf(targets[adjacent[i]]);
+            int const cWeight = weightAt(sources[adjacent[i]]) + weightAt(targets[adjacent[i]]);
+
+            // Adjacent edges against all others
+            forOverlapping(Box::around(aStart, aEnd), 0, cEdges, [&](long const bEdgeId) {
+                int const bStart = sources[bEdgeId];
+                int const bEnd = targets[bEdgeId];
+                if(bStart == aVertexId || bEnd == aVertexId || bStart == bVertexId || bEnd == bVertexId)
+                    return true;
+
+                bool const nonCollinear = isNonCollinear(cWeight + genericWeights[bStart] + genericWeights[bEnd]);
+                score += VectorSpace::evalSegments(aStart, aEnd, Pos{xs[bStart], ys[bStart]}, Pos{xs[bEnd], ys[bEnd]}, penalty, nonCollinear);
+                return score <= limit;
+            });
+            if(score > limit)
+                return score;
+
+            // Adjacent edges among each other
+            for (size_t j=i+1; j<adjacent.size(); j++) {
+                bool const nonCollinear = isNonCollinear(cWeight + weightAt(sources[adjacent[j]]) + weightAt(targets[adjacent[j]]));
+                score += VectorSpace::evalSegments(aStart, aEnd, posOf(sources[adjacent[j]]), posOf(targets[adjacent[j]]),
+                                                   penalty, nonCollinear);
+            }
+        }
+
+        return score;
     }
 
     /**
@@ -357,34 +956,33 @@ protected:
      */
     void prepareTracker() {
         if(!isTrackerReady) {
+            TELEMETRY_PHASE(prepareTracker);
             scoreTracker = 0;
 
-            for (auto aEdge = gamma.edges.begin(); aEdge != gamma.edges.end(); ++aEdge) {
-                Vertex &aStart = gamma.getVertex(aEdge->aVertexId);
-                Vertex &aEnd = gamma.getVertex(aEdge->bVertexId);
-
-                // Skip edges with ignored vertices
-                if(aStart.ignored || aEnd.ignored)
-                    continue;
-
-                for (auto bEdge = next(aEdge); bEdge != gamma.edges.end(); ++bEdge) {
-                    Vertex &bStart = gamma.getVertex(bEdge->aVertexId);
-                    Vertex &bEnd = gamma.getVertex(bEdge->bVertexId);
+            int32_t const *sources = gamma.sources().data();
+            int32_t const *targets = gamma.targets().data();
+            long *temps = gamma.temps.data();
+            long const cEdges = static_cast<long>(gamma.sources().size());
 
-                    // Skip edges with ignored vertices
-                    if(bStart.ignored || bEnd.ignored)
-                        continue;
+            for (long aEdgeId=0; aEdgeId<cEdges; aEdgeId++) {
+                long row = 0;
 
-                    // Sum crossings in the score tracker
-                    long const pen = cross(*aEdge, *bEdge);
-                    scoreTracker += pen;
+                forOverlapping(gamma.boxOf(static_cast<int>(aEdgeId)), aEdgeId + 1, cEdges, [&](long const bEdgeId) {
+                    long const pen = cross(static_cast<int>(aEdgeId), static_cast<int>(bEdgeId));
+                    if(pen == 0)
+                        return true;
 
                     // Sum penalties as local temperatures
-                    aStart.temp += pen;
-                    aEnd.temp += pen;
-                    bStart.temp += pen;
-                    bEnd.temp += pen;
-                }
+                    temps[sources[bEdgeId]] += pen;
+                    temps[targets[bEdgeId]] += pen;
+                    row += pen;
+                    return true;
+                });
+
+                // Sum crossings in the score tracker
+                temps[sources[aEdgeId]] += row;
+                temps[targets[aEdgeId]] += row;
+                scoreTracker += row;
             }
 
             // The tracker is now prepared
@@ -397,74 +995,68 @@ protected:
     /**
      * Determines the penalty on a vertex's adjacent edges.
      * Updates the local temperatures immediately in one.
+     * @param vertexId ID of the vertex.
+     * @param penSign Subtracts the impact before a modification and adds it afterwards.
+     * @param ignoredId ID of a vertex whose edges are skipped, e.g., the partner of an exchange.
      */
-    long pen(int const &vertexId, TrackerMode penSign) {
+    long pen(int const &vertexId, TrackerMode penSign, int const &ignoredId = -1) {
+        TELEMETRY_PHASE(pen);
         long score = 0;
 
-        Vertex &vertex = gamma.getVertex(vertexId);
-        vector<int> neighbourIds = gamma.getNeighbours(vertex.id);
+        int32_t const *sources = gamma.sources().data();
+        int32_t const *targets = gamma.targets().data();
+        long *temps = gamma.temps.data();
+        long const cEdges = static_cast<long>(gamma.sources().size());
 
-        for (int const neighbourId: neighbourIds) {
-            Edge &aEdge = gamma.getEdge(vertex.id, neighbourId);
-            Vertex &aStart = gamma.getVertex(aEdge.aVertexId);
-            Vertex &aEnd = gamma.getVertex(aEdge.bVertexId);
+        vector<int> const &incident = gamma.getIncidentEdges(vertexId);
+        auto const isIgnored = [&](int const edgeId) {
+            return sources[edgeId] == ignoredId || targets[edgeId] == ignoredId;
+        };
 
-            // Skip edges with ignored vertices
-            if(aStart.ignored || aEnd.ignored)
+        for (int const aEdgeId : incident) {
+            if(isIgnored(aEdgeId))
                 continue;
 
-            for (auto &bEdge: gamma.edges) {
-                Vertex &bStart = gamma.getVertex(bEdge.aVertexId);
-                Vertex &bEnd = gamma.getVertex(bEdge.bVertexId);
-
-                // Skip edges with ignored vertices
-                if(bStart.ignored || bEnd.ignored)
-                    continue;
+            long row = 0;
+            forOverlapping(gamma.boxOf(aEdgeId), 0, cEdges, [&](long const bEdgeId) {
+                int const bStart = sources[bEdgeId];
+                int const bEnd = targets[bEdgeId];
 
                 // Edges to neighbours must be calculated in the subsequent loop
-                if(bEdge.aVertexId == vertex.id || bEdge.bVertexId == vertex.id)
-                    continue;
+                if(bStart == vertexId || bEnd == vertexId || bStart == ignoredId || bEnd == ignoredId)
+                    return true;
 
-                // Updates the local temperatures
-                // Impact is subtracted before the modification and then added again
-                long pen = cross(aEdge, bEdge);
-                aStart.temp += penSign * pen;
-                aEnd.temp += penSign * pen;
-                bStart.temp += penSign * pen;
-                bEnd.temp += penSign * pen;
+                long const pen = cross(aEdgeId, static_cast<int>(bEdgeId));
+                if(pen == 0)
+                    return true;
 
-                score += pen;
-            }
+                // Updates the local temperatures
+                temps[bStart] += penSign * pen;
+                temps[bEnd] += penSign * pen;
+                row += pen;
+                return true;
+            });
+
+            temps[sources[aEdgeId]] += penSign * row;
+            temps[targets[aEdgeId]] += penSign * row;
+            score += row;
         }
 
         // Without this separate loop for the neighbours, deviating scores occurred
-        for (int i=0; i<neighbourIds.size(); i++) {
-            Vertex const &neighbour = gamma.getVertex(neighbourIds[i]);
-            Edge &aEdge = gamma.getEdge(vertex.id, neighbour.id);
-            Vertex &aStart = gamma.getVertex(aEdge.aVertexId);
-            Vertex &aEnd = gamma.getVertex(aEdge.bVertexId);
-
-            // Skip edges with ignored vertices
-            if(aStart.ignored || aEnd.ignored)
+        for (size_t i=0; i<incident.size(); i++) {
+            if(isIgnored(incident[i]))
                 continue;
 
-            for(int j=i+1; j<neighbourIds.size(); j++) {
-                Vertex const &otherNeighbour = gamma.getVertex(neighbourIds[j]);
-                Edge &bEdge = gamma.getEdge(vertex.id, otherNeighbour.id);
-                Vertex &bStart = gamma.getVertex(bEdge.aVertexId);
-                Vertex &bEnd = gamma.getVertex(bEdge.bVertexId);
-
-                // Skip edges with ignored vertices
-                if(bStart.ignored || bEnd.ignored)
+            for(size_t j=i+1; j<incident.size(); j++) {
+                if(isIgnored(incident[j]))
                     continue;
 
                 // Updates the local temperatures
-                // Impact is subtracted before the modification and then added again
-                long pen = cross(aEdge, bEdge);
-                aStart.temp += penSign * pen;
-                aEnd.temp += penSign * pen;
-                bStart.temp += penSign * pen;
-                bEnd.temp += penSign * pen;
+                long const pen = cross(incident[i], incident[j]);
+                temps[sources[incident[i]]] += penSign * pen;
+                temps[targets[incident[i]]] += penSign * pen;
+                temps[sources[incident[j]]] += penSign * pen;
+                temps[targets[incident[j]]] += penSign * pen;
 
                 score += pen;
             }
@@ -32,8 +32,27 @@ struct Position {
 };
 
 
+/**
+ * Exact position on the integer grid. Points are always on the grid, vertices only if they were moved onto points.
+ */
+struct Coordinate {
+    int64_t x;
+    int64_t y;
+
+    bool operator==(Coordinate const &other) const {
+        return x == other.x && y == other.y;
+    }
+
+    bool operator!=(Coordinate const &other) const {
+        return !(*this == other);
+    }
+};
+
+
 class VectorSpace {
 public:
+    // Grid positions are limited to integers that are exactly representable as double
+    static constexpr double GRID_LIMIT = 9007199254740992.0;
 
     /**
      * Evaluates a cross for two segments.
@@ -42,44 +61,23 @@ public:
      * @param bStart The second segment's start.
      * @param bEnd The second segment's end.
      * @param pen Penalty value for endpoints on segments.
+     * @param nonCollinear Are no three of the endpoints collinear? Skips the checks for endpoints on segments.
      */
-    static long evalSegments(const Position &aStart, const Position &aEnd, const Position &bStart, const Position &bEnd, int const pen) {
-        if(! ((aStart == bStart && aEnd == bEnd) || (aStart == bEnd && aEnd == bStart))){
-            // Do the curves share no common endpoint?
-            if (dist(aStart, bStart) > EPS && dist(aEnd, bEnd) > EPS &&
-                dist(aStart, bEnd) > EPS && dist(aEnd, bStart) > EPS) {
-
-                // Is a endpoint of aSegment on bSegment or vice versa?
-                if (onSegment(aStart, bStart, bEnd) || onSegment(aEnd, bStart, bEnd) ||
-                    onSegment(bStart, aStart, aEnd) || onSegment(bEnd, aStart, aEnd)) {
-
-                    return pen;
-                }
-
-                // Do the segments intersect?
-                if(doCross(aStart, aEnd, bStart, bEnd))
-                    return 1;
-            }
-            else {
-                // Is the unshared endpoint of aEdge on bEdge or vice versa?
-                if (dist(aStart, bStart) < EPS)
-                    if (onSegment(aEnd, bStart, bEnd) || onSegment(bEnd, aStart, aEnd))
-                        return pen;
-
-                if(dist(aEnd, bStart) < EPS)
-                    if (onSegment(aStart, bStart, bEnd) || onSegment(bEnd, aStart, aEnd))
-                        return pen;
-
-                if (dist(aStart, bEnd) < EPS)
-                    if (onSegment(aEnd, bStart, bEnd) || onSegment(bStart, aStart, aEnd))
-                        return pen;
+    static long evalSegments(const Position &aStart, const Position &aEnd, const Position &bStart, const Position &bEnd, int const pen,
+                             bool const nonCollinear = false) {
+        long const result = evaluate(aStart, aEnd, bStart, bEnd, pen, nonCollinear);
+        TELEMETRY_OUTCOME(result, pen);
+        return result;
+    }
 
-                if(dist(aEnd, bEnd) < EPS)
-                    if (onSegment(aStart, bStart, bEnd) || onSegment(bStart, aStart, aEnd))
-                        return pen;
-            }
-        }
-        return 0;
+    /**
+     * Evaluates a cross for two segments on the grid. Needs neither square roots nor tolerances.
+     */
+    static long evalSegments(const Coordinate &aStart, const Coordinate &aEnd, const Coordinate &bStart, const Coordinate &bEnd, int const pen,
+                             bool const nonCollinear = false) {
+        long const result = evaluate(aStart, aEnd, bStart, bEnd, pen, nonCollinear);
+        TELEMETRY_OUTCOME(result, pen);
+        return result;
     }
 
     /**
@@ -89,16 +87,7 @@ public:
      * @param end The segment's end.
      */
     static bool onSegment(const Position &pos, const Position &start, const Position &end) {
-        // Check x interval
-        if (start.x < pos.x && end.x < pos.x)
-            return false;
-        if (start.x > pos.x && end.x > pos.x)
-            return false;
-
-        // Check y interval
-        if (start.y < pos.y && end.y < pos.y)
-            return false;
-        if (start.y > pos.y && end.y > pos.y)
+        if(!inBox(pos, start, end))
             return false;
 
         // Vertical line case
@@ -113,6 +102,19 @@ public:
         return (start.x - pos.x) * (end.y - pos.y) == (pos.x - end.x) * (pos.y - start.y);
     }
 
+    static bool onSegment(const Coordinate &pos, const Coordinate &start, const Coordinate &end) {
+        if(!inBox(pos, start, end))
+            return false;
+
+        // Same cases as for positions
+        if (start.x == pos.x)
+            return end.x == pos.x;
+        if (start.y == pos.y)
+            return end.y == pos.y;
+
+        return static_cast<__int128>(start.x - pos.x) * (end.y - pos.y) == static_cast<__int128>(pos.x - end.x) * (pos.y - start.y);
+    }
+
     /**
      * Do the segments cross?
      * @param aStart The first segment's start.
@@ -144,11 +146,34 @@ public:
         return true;
     }
 
+    /**
+     * Do the segments cross properly? Touching segments are handled by onSegment beforehand.
+     */
+    static bool doCross(const Coordinate &aStart, const Coordinate &aEnd, const Coordinate &bStart, const Coordinate &bEnd) {
+        if ((aStart == bStart && aEnd == bEnd) || (aStart == bEnd && aEnd == bStart))
+            return false;
+
+        // The signs are exact, so a collinear point is on neither side
+        if (orient(aStart, aEnd, bStart) * orient(aStart, aEnd, bEnd) >= 0)
+            return false;
+        if (orient(bStart, bEnd, aStart) * orient(bStart, bEnd, aEnd) >= 0)
+            return false;
+
+        return true;
+    }
+
     static double orient(const Position &aPos, const Position &bPos, const Position &cPos) {
         // Calculates the orientation and returns the signum
         return copysign(1.0, (bPos.x * cPos.y - cPos.x * bPos.y) + (cPos.x * aPos.y - aPos.x * cPos.y) + (aPos.x * bPos.y - bPos.x * aPos.y));
      }
 
+    static int orient(const Coordinate &aPos, const Coordinate &bPos, const Coordinate &cPos) {
+        // The determinant of grid differences fits into 128 bits
+        __int128 const det = static_cast<__int128>(bPos.x - aPos.x) * (cPos.y - aPos.y)
+                           - static_cast<__int128>(bPos.y - aPos.y) * (cPos.x - aPos.x);
+        return (det > 0) - (det < 0);
+    }
+
     static double dist(const Position &aPos, const Position &bPos) {
         // Creates vector and returns its length
         double const xDist = aPos.x - bPos.x;
@@ -163,6 +188,96 @@ public:
             return numeric_limits<double>::quiet_NaN();
         return norm;
     }
+
+    /**
+     * Is the position an integral position within the grid?
+     */
+    static bool onGrid(Position const &pos) {
+        return pos.x == floor(pos.x) && pos.y == floor(pos.y) && fabs(pos.x) < GRID_LIMIT && fabs(pos.y) < GRID_LIMIT;
+    }
+
+    static Coordinate toCoordinate(Position const &pos) {
+        return {static_cast<int64_t>(pos.x), static_cast<int64_t>(pos.y)};
+    }
+
+private:
+    static bool coincide(const Position &aPos, const Position &bPos) {
+        return dist(aPos, bPos) < EPS;
+    }
+
+    static bool coincide(const Coordinate &aPos, const Coordinate &bPos) {
+        return aPos == bPos;
+    }
+
+    /**
+     * Does the bounding box of the segment contain the position?
+     */
+    template<typename Pos>
+    static bool inBox(const Pos &pos, const Pos &start, const Pos &end) {
+        // Check x interval
+        if (start.x < pos.x && end.x < pos.x)
+            return false;
+        if (start.x > pos.x && end.x > pos.x)
+            return false;
+
+        // Check y interval
+        if (start.y < pos.y && end.y < pos.y)
+            return false;
+        if (start.y > pos.y && end.y > pos.y)
+            return false;
+
+        return true;
+    }
+
+    /**
+     * Shared case distinction of evalSegments for both kinds of positions.
+     */
+    template<typename Pos>
+    static long evaluate(const Pos &aStart, const Pos &aEnd, const Pos &bStart, const Pos &bEnd, int const pen, bool const nonCollinear) {
+        // Without collinear endpoints, no endpoint can be on the other segment
+        if(nonCollinear && !coincide(aStart, aEnd) && !coincide(bStart, bEnd)) {
+            if(coincide(aStart, bStart) || coincide(aEnd, bEnd) || coincide(aStart, bEnd) || coincide(aEnd, bStart))
+                return 0;
+            return doCross(aStart, aEnd, bStart, bEnd) ? 1 : 0;
+        }
+
+        if(! ((aStart == bStart && aEnd == bEnd) || (aStart == bEnd && aEnd == bStart))){
+            // Do the curves share no common endpoint?
+            if (!coincide(aStart, bStart) && !coincide(aEnd, bEnd) &&
+                !coincide(aStart, bEnd) && !coincide(aEnd, bStart)) {
+
+                // Is a endpoint of aSegment on bSegment or vice versa?
+                if (onSegment(aStart, bStart, bEnd) || onSegment(aEnd, bStart, bEnd) ||
+                    onSegment(bStart, aStart, aEnd) || onSegment(bEnd, aStart, aEnd)) {
+
+                    return pen;
+                }
+
+                // Do the segments intersect?
+                if(doCross(aStart, aEnd, bStart, bEnd))
+                    return 1;
+            }
+            else {
+                // Is the unshared endpoint of aEdge on bEdge or vice versa?
+                if (coincide(aStart, bStart))
+                    if (onSegment(aEnd, bStart, bEnd) || onSegment(bEnd, aStart, aEnd))
+                        return pen;
+
+                if(coincide(aEnd, bStart))
+                    if (onSegment(aStart, bStart, bEnd) || onSegment(bEnd, aStart, aEnd))
+                        return pen;
+
+                if (coincide(aStart, bEnd))
+                    if (onSegment(aEnd, bStart, bEnd) || onSegment(bStart, aStart, aEnd))
+                        return pen;
+
+                if(coincide(aEnd, bEnd))
+                    if (onSegment(aStart, bStart, bEnd) || onSegment(bStart, aStart, aEnd))
+                        return pen;
+            }
+        }
+        return 0;
+    }
 };
 
 
@@ -219,46 +334,155 @@ private:
 };
 
 
+/**
+ * Small and fast generator xoshiro256**, which satisfies the requirements of a uniform random bit generator.
+ * @reference https://prng.di.unimi.it/
+ */
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    /**
+     * Expands a single seed into the state by SplitMix64.
+     * @param seed The seed.
+     */
+    explicit Xoshiro256(uint64_t seed) {
+        for (uint64_t &word : state) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t mixed = seed;
+            mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+            word = mixed ^ (mixed >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        uint64_t const result = rotl(state[1] * 5, 7) * 9;
+        uint64_t const shifted = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= shifted;
+        state[3] = rotl(state[3], 45);
+
+        return result;
+    }
+
+    /**
+     * Draws an unbiased value from [0, range) by Lemire's multiply-shift method.
+     * @param range Number of possible values, must be positive.
+     */
+    uint64_t bounded(uint64_t const range) {
+        unsigned __int128 product = static_cast<unsigned __int128>((*this)()) * range;
+        auto low = static_cast<uint64_t>(product);
+
+        // Rejects the few values that would favour some results
+        if (low < range) {
+            uint64_t const threshold = -range % range;
+            while (low < threshold) {
+                product = static_cast<unsigned __int128>((*this)()) * range;
+                low = static_cast<uint64_t>(product);
+            }
+        }
+        return static_cast<uint64_t>(product >> 64);
+    }
+
+private:
+    uint64_t state[4]{};
+
+    static uint64_t rotl(uint64_t const value, int const shift) {
+        return (value << shift) | (value >> (64 - shift));
+    }
+};
+
+
+/**
+ * Retrieves the generator of the current thread. Unless seedThread is called, it is seeded by clock and thread.
+ */
+inline Xoshiro256 &threadGenerator() {
+    thread_local Xoshiro256 generator(system_clock::now().time_since_epoch().count() +
+                                      hash<thread::id>{}(this_thread::get_id()));
+    return generator;
+}
+
+/**
+ * Makes the random values of the current thread reproducible.
+ * @param seed The seed.
+ */
+inline void seedThread(uint64_t const seed) {
+    threadGenerator() = Xoshiro256(seed);
+}
+
+/**
+ * Draws the seeds of worker threads from the generator of the current thread before they are spawned, so seeded
+ * runs remain reproducible regardless of the order in which the workers start.
+ * @param cSeeds Number of workers.
+ */
+inline vector<uint64_t> drawSeeds(int const cSeeds) {
+    vector<uint64_t> seeds(cSeeds);
+    for(auto &seed : seeds)
+        seed = threadGenerator()();
+    return seeds;
+}
+
+
 template<typename Num>
 class NumRandomizer {
 private:
-    // Thread-local generator and distribution
-    thread_local static std::mt19937 gen;
-    uniform_int_distribution<Num> distrib;
+    Num start;
+
+    // Number of values in the range
+    uint64_t range;
 
 public:
-    NumRandomizer() : distrib(0, 99) {
-        initialize_gen();
-    }
+    NumRandomizer() : NumRandomizer(0, 99) { }
 
     /**
      * @param start Start of the range.
      * @param end End of the range.
      */
-    NumRandomizer(Num const start, Num const end) : distrib(start, end) {
-        initialize_gen();
-    }
+    NumRandomizer(Num const start, Num const end)
+        : start(start), range(static_cast<uint64_t>(end) - static_cast<uint64_t>(start) + 1) { }
 
     /**
      * Returns a random value within the range.
      */
     Num pull() {
-        return distrib(gen);
-    }
-
-private:
-    static void initialize_gen() {
-        static thread_local bool initialized = false;
-        if (!initialized) {
-            gen.seed(std::chrono::system_clock::now().time_since_epoch().count() + std::hash<std::thread::id>{}(std::this_thread::get_id()));
-            initialized = true;
-        }
+        TELEMETRY_COUNT(randomDraws);
+        return static_cast<Num>(static_cast<uint64_t>(start) + threadGenerator().bounded(range));
     }
 };
 
-template<typename Num>
-thread_local std::mt19937 NumRandomizer<Num>::gen;
 
+/**
+ * Calculates the position of a cell along a Hilbert curve, which keeps spatially close cells close in order.
+ * @param x X-coordinate of the cell.
+ * @param y Y-coordinate of the cell.
+ * @param order The curve covers a grid of 2^order x 2^order cells.
+ */
+inline uint64_t hilbertIndex(uint32_t x, uint32_t y, int const order = 16) {
+    uint64_t index = 0;
+    for (uint32_t side = 1u << (order - 1); side > 0; side >>= 1) {
+        uint32_t const rx = (x & side) > 0;
+        uint32_t const ry = (y & side) > 0;
+        index += static_cast<uint64_t>(side) * side * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant, so the curve continues in the sub-grid
+        if (ry == 0) {
+            if (rx == 1) {
+                x = side - 1 - (x & (side - 1));
+                y = side - 1 - (y & (side - 1));
+            }
+            swap(x, y);
+        }
+    }
+    return index;
+}
 
 /**
  * Converts a duration to a pretty string.
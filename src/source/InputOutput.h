@@ -15,13 +15,17 @@ public:
     string inputDir;
     string outputDir;
 
+    // Renumber points, vertices and edges along a Hilbert curve for cache locality
+    bool renumber = false;
+
     /**
       * @param input Input directory path.
       * @param output Output directory path.
+      * @param renumber Renumber the loaded instances along a Hilbert curve.
       * @throws runtime_error if the output directory cannot be created.
       */
-    InputOutput(string input, string output)
-        : inputDir(std::move(input)), outputDir(std::move(output)) {
+    InputOutput(string input, string output, bool const renumber = false)
+        : inputDir(std::move(input)), outputDir(std::move(output)), renumber(renumber) {
 
         // Exactly one trailing separator is allowed
         while (!inputDir.empty() && inputDir.back() == '/')
@@ -40,6 +44,17 @@ public:
                 throw runtime_error("Failed to create output directory: " + outputDir);
     }
 
+    /**
+     * Copies the state of loaded instances, e.g., their original IDs, for another output directory.
+     * @param output Output directory path.
+     * @throws runtime_error if the output directory cannot be created.
+     */
+    [[nodiscard]] InputOutput withOutput(string output) const {
+        InputOutput copy = *this;
+        copy.outputDir = InputOutput(inputDir, std::move(output), renumber).outputDir;
+        return copy;
+    }
+
     /**
      * Loads a PSE from a specified file within the input directory.
      * @param name The file or relative dir-path to be loaded.
@@ -81,12 +96,17 @@ public:
         for (const auto& vertex : jsonData["nodes"])
             vertices[vertex["id"]] = {vertex["id"], vertex["x"], vertex["y"]};
 
+        vector<pair<int, int>> endpoints;
+        for (const auto& edge : jsonData["edges"])
+            endpoints.emplace_back(edge["source"], edge["target"]);
+
+        originalIds.clear();
+        if (renumber)
+            renumberAlongCurve(points, vertices, endpoints);
+
         vector<Edge> edges;
-        for (const auto& edge : jsonData["edges"]) {
-            Vertex sourceVertex = vertices[edge["source"]];
-            Vertex targetVertex = vertices[edge["target"]];
-            edges.emplace_back(edges.size(), sourceVertex, targetVertex);
-        }
+        for (auto const &[source, target] : endpoints)
+            edges.emplace_back(edges.size(), vertices[source], vertices[target]);
 
         int const drawingWidth = jsonData.contains("width") ? jsonData["width"].get<int>() : 1000000;
         int const drawingHeight = jsonData.contains("height") ? jsonData["height"].get<int>() : 1000000;
@@ -128,13 +148,101 @@ public:
      */
     string stringify(PSE& emb) {
         jsonData["nodes"] = {};
-        for (Vertex& vertex : emb.gamma.vertices)
-            jsonData["nodes"].push_back(vertex.toJson());
+        if (originalIds.empty()) {
+            for (Vertex& vertex : emb.gamma.vertices)
+                jsonData["nodes"].push_back(vertex.toJson());
+        }
+        else {
+            // Restore the input's IDs and order
+            vector<int> renumbered(originalIds.size());
+            for (int vertexId=0; vertexId<static_cast<int>(originalIds.size()); vertexId++)
+                renumbered[originalIds[vertexId]] = vertexId;
+
+            for (int const vertexId : renumbered) {
+                json node = emb.gamma.getVertex(vertexId).toJson();
+                node["id"] = originalIds[vertexId];
+                jsonData["nodes"].push_back(node);
+            }
+        }
         return jsonData.dump(4);
     }
 
 private:
     json jsonData;
+
+    // Input ID per renumbered vertex, empty without renumbering
+    vector<int> originalIds;
+
+    /**
+     * Sorts points and vertices by the Hilbert index of their positions, edges by the index of their midpoints.
+     * Only vertex IDs appear in the output, so only their original IDs must be kept.
+     * @param points The points to be renumbered.
+     * @param vertices The vertices to be renumbered.
+     * @param endpoints Endpoints per edge, which are updated and reordered.
+     */
+    void renumberAlongCurve(vector<Point> &points, vector<Vertex> &vertices, vector<pair<int, int>> &endpoints) {
+        // Scale the bounding box of all positions to the curve's grid
+        double minX = numeric_limits<double>::max(), maxX = numeric_limits<double>::lowest();
+        double minY = numeric_limits<double>::max(), maxY = numeric_limits<double>::lowest();
+        auto const extend = [&](Position const &pos) {
+            minX = min(minX, pos.x);
+            maxX = max(maxX, pos.x);
+            minY = min(minY, pos.y);
+            maxY = max(maxY, pos.y);
+        };
+        for (Point const &point : points)
+            extend(point.pos);
+        for (Vertex const &vertex : vertices)
+            extend(vertex.pos);
+
+        double const cells = (1 << 16) - 1;
+        double const scale = cells / max(1.0, max(maxX - minX, maxY - minY));
+        auto const curveIndex = [&](double const x, double const y) {
+            return hilbertIndex(static_cast<uint32_t>((x - minX) * scale), static_cast<uint32_t>((y - minY) * scale));
+        };
+
+        // Returns the new order as list of old IDs
+        auto const sortedIds = [](vector<uint64_t> const &keys) {
+            vector<int> order(keys.size());
+            iota(order.begin(), order.end(), 0);
+            stable_sort(order.begin(), order.end(), [&keys](int const a, int const b) { return keys[a] < keys[b]; });
+            return order;
+        };
+
+        vector<uint64_t> keys;
+        for (Point const &point : points)
+            keys.push_back(curveIndex(point.pos.x, point.pos.y));
+        vector<Point> sortedPoints;
+        for (int const pointId : sortedIds(keys))
+            sortedPoints.emplace_back(static_cast<int>(sortedPoints.size()), static_cast<int>(points[pointId].pos.x),
+                                      static_cast<int>(points[pointId].pos.y));
+        points = std::move(sortedPoints);
+
+        keys.clear();
+        for (Vertex const &vertex : vertices)
+            keys.push_back(curveIndex(vertex.pos.x, vertex.pos.y));
+        originalIds = sortedIds(keys);
+
+        vector<int> newIds(vertices.size());
+        vector<Vertex> sortedVertices;
+        for (int const vertexId : originalIds) {
+            newIds[vertexId] = static_cast<int>(sortedVertices.size());
+            sortedVertices.emplace_back(newIds[vertexId], vertices[vertexId].pos.x, vertices[vertexId].pos.y);
+        }
+        vertices = std::move(sortedVertices);
+
+        keys.clear();
+        for (auto &[source, target] : endpoints) {
+            source = newIds[source];
+            target = newIds[target];
+            keys.push_back(curveIndex((vertices[source].pos.x + vertices[target].pos.x) / 2,
+                                      (vertices[source].pos.y + vertices[target].pos.y) / 2));
+        }
+        vector<pair<int, int>> sortedEndpoints;
+        for (int const edgeId : sortedIds(keys))
+            sortedEndpoints.push_back(endpoints[edgeId]);
+        endpoints = std::move(sortedEndpoints);
+    }
 };
 
 #endif
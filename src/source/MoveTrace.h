@@ -0,0 +1,207 @@
+#ifndef PROJECT_MOVE_TRACE_H
+#define PROJECT_MOVE_TRACE_H
+
+#include "dependencies.h"
+
+using namespace std;
+
+
+/**
+ * Binary format of recorded proposals. After the magic, the file consists of pairs of 32-bit words:
+ * (START, |V|) followed by the occupied point of each vertex, (vertex, point << 2 | accepted << 1 | last) per move,
+ * where a proposal ends with its last move, (RESTORE, 0) whenever the best assignment is restored and
+ * (END, 0) followed by the final score as two words.
+ */
+struct MoveTrace {
+    static constexpr char MAGIC[8] = {'P', 'S', 'E', 'M', 'O', 'V', 'E', '1'};
+    static constexpr uint32_t START = 0xFFFFFFFD;
+    static constexpr uint32_t RESTORE = 0xFFFFFFFE;
+    static constexpr uint32_t END = 0xFFFFFFFF;
+};
+
+
+/**
+ * Records the proposals of an optimization for the replay benchmark. Words are buffered and written in blocks.
+ */
+class MoveRecorder {
+public:
+    /**
+     * @param path Path of the file, which is truncated.
+     * @throws runtime_error if the file cannot be opened.
+     */
+    explicit MoveRecorder(string const &path) : file(path, ios::binary | ios::trunc) {
+        if (!file.is_open())
+            throw runtime_error("Move trace cannot be opened: " + path);
+        file.write(MoveTrace::MAGIC, sizeof(MoveTrace::MAGIC));
+    }
+
+    ~MoveRecorder() {
+        flush();
+    }
+
+    MoveRecorder(MoveRecorder const &) = delete;
+    MoveRecorder &operator=(MoveRecorder const &) = delete;
+
+    /**
+     * Starts a segment with the current assignment. All vertices must occupy points.
+     */
+    void start(PSE const &emb) {
+        put(MoveTrace::START, static_cast<uint32_t>(emb.gamma.vertices.size()));
+        for (Vertex const &vertex : emb.gamma.vertices)
+            put(static_cast<uint32_t>(vertex.occupiedPoint));
+    }
+
+    /**
+     * Records a proposal, i.e., a sequence of moveOrSwap, which is accepted or rejected as a whole.
+     * @param moves Vertices and target points.
+     * @param accepted Is the proposal accepted?
+     */
+    void proposal(vector<pair<int, int>> const &moves, bool const accepted) {
+        for (size_t i=0; i<moves.size(); i++) {
+            uint32_t const flags = (accepted ? 2u : 0u) | (i + 1 == moves.size() ? 1u : 0u);
+            put(static_cast<uint32_t>(moves[i].first), static_cast<uint32_t>(moves[i].second) << 2 | flags);
+        }
+    }
+
+    /**
+     * Records that the best assignment of the segment is restored.
+     */
+    void restore() {
+        put(MoveTrace::RESTORE, 0);
+    }
+
+    /**
+     * Ends a segment.
+     * @param score Tracked score of the current assignment.
+     */
+    void end(long const score) {
+        put(MoveTrace::END, 0);
+        put(static_cast<uint32_t>(static_cast<uint64_t>(score) >> 32), static_cast<uint32_t>(score));
+        flush();
+    }
+
+private:
+    static constexpr size_t BLOCK = 1 << 16;
+
+    ofstream file;
+    array<uint32_t, BLOCK> buffer{};
+    size_t cBuffered = 0;
+
+    void put(uint32_t const word) {
+        buffer[cBuffered++] = word;
+        if (cBuffered == BLOCK)
+            flush();
+    }
+
+    void put(uint32_t const first, uint32_t const second) {
+        put(first);
+        put(second);
+    }
+
+    void flush() {
+        file.write(reinterpret_cast<char const *>(buffer.data()), static_cast<streamsize>(cBuffered * sizeof(uint32_t)));
+        file.flush();
+        cBuffered = 0;
+    }
+};
+
+
+/**
+ * Reads a move trace entirely into memory, so replays are not slowed down by the disk.
+ */
+class MoveReader {
+public:
+    enum Kind {start, move, restore, end};
+
+    /**
+     * @param path Path of the recorded trace.
+     * @throws runtime_error if the file cannot be read or is no move trace.
+     */
+    explicit MoveReader(string const &path) {
+        ifstream file(path, ios::binary);
+        char magic[sizeof(MoveTrace::MAGIC)];
+        if (!file.is_open() || !file.read(magic, sizeof(magic)) || !equal(magic, magic + sizeof(magic), MoveTrace::MAGIC))
+            throw runtime_error("No move trace: " + path);
+
+        uint32_t word;
+        while (file.read(reinterpret_cast<char *>(&word), sizeof(word)))
+            words.push_back(word);
+    }
+
+    [[nodiscard]] bool hasNext() const {
+        return pos + 1 < words.size();
+    }
+
+    /**
+     * Reads the kind of the next record and positions the reader at its data.
+     */
+    Kind next() {
+        uint32_t const first = words[pos];
+        if (first == MoveTrace::START)
+            return start;
+        if (first == MoveTrace::RESTORE) {
+            pos += 2;
+            return restore;
+        }
+        if (first == MoveTrace::END)
+            return end;
+        return move;
+    }
+
+    /**
+     * Reads the assignment of a start record.
+     * @throws runtime_error if the trace ends within the record.
+     */
+    vector<int> assignment() {
+        require(2);
+        uint32_t const cVertices = words[pos + 1];
+        require(2 + static_cast<size_t>(cVertices));
+        vector<int> points(words.begin() + static_cast<long>(pos) + 2, words.begin() + static_cast<long>(pos + 2 + cVertices));
+        pos += 2 + cVertices;
+        return points;
+    }
+
+    /**
+     * Reads a move record.
+     * @return Vertex, target point, is the proposal accepted and is it the proposal's last move?
+     * @throws runtime_error if the trace ends within the record.
+     */
+    tuple<int, int, bool, bool> moveRecord() {
+        require(2);
+        uint32_t const vertexId = words[pos];
+        uint32_t const packed = words[pos + 1];
+        pos += 2;
+        return {static_cast<int>(vertexId), static_cast<int>(packed >> 2), (packed & 2u) != 0, (packed & 1u) != 0};
+    }
+
+    /**
+     * Reads the final score of an end record.
+     * @throws runtime_error if the trace ends within the record.
+     */
+    long score() {
+        require(4);
+        uint64_t const high = words[pos + 2];
+        uint64_t const low = words[pos + 3];
+        pos += 4;
+        return static_cast<long>(high << 32 | low);
+    }
+
+    [[nodiscard]] size_t cWords() const {
+        return words.size();
+    }
+
+private:
+    vector<uint32_t> words;
+    size_t pos = 0;
+
+    /**
+     * Ensures that the current record is complete, e.g., unlike the last record of a killed recording.
+     * @param cRecord Number of words of the record.
+     */
+    void require(size_t const cRecord) const {
+        if (pos + cRecord > words.size())
+            throw runtime_error("Truncated move trace");
+    }
+};
+
+#endif
@@ -0,0 +1,160 @@
+#ifndef PROJECT_ORIENTATION_TABLE_H
+#define PROJECT_ORIENTATION_TABLE_H
+
+#include "dependencies.h"
+
+using namespace std;
+using namespace chrono;
+
+
+/**
+ * Precomputed orientations of all point triples. Each unordered triple i < j < k is stored by two bits at its
+ * position in the combinatorial number system, so the table needs (n choose 3) / 4 bytes.
+ */
+class OrientationTable {
+public:
+    // Larger tables are not built, since lookups would miss the caches anyway
+    // Without the build option, the exact predicates are faster and no table is built at all
+#ifdef ORIENTATION_TABLE
+    static constexpr size_t MAX_BYTES = 16 << 20;
+#else
+    static constexpr size_t MAX_BYTES = 0;
+#endif
+
+    // Time needed to build the table in ms
+    long buildTime = 0;
+
+    OrientationTable() = default;
+
+    /**
+     * Builds the table in parallel if it does not exceed MAX_BYTES.
+     * @param coordinates Positions of the points, indexed by point ID.
+     */
+    explicit OrientationTable(vector<Coordinate> const &coordinates) {
+        auto const start = high_resolution_clock::now();
+        long const cPoints = static_cast<long>(coordinates.size());
+        long const cTriples = choose3(cPoints);
+        if(cPoints < 3 || static_cast<size_t>((cTriples + 3) / 4) > MAX_BYTES)
+            return;
+
+        long const cWords = (cTriples + TRIPLES_PER_WORD - 1) / TRIPLES_PER_WORD;
+        words.assign(cWords, 0);
+
+        // Threads fill disjoint ranges of words, so no word is shared
+        int const cThreads = static_cast<int>(max(1u, thread::hardware_concurrency()));
+        long const chunk = (cWords + cThreads - 1) / cThreads;
+
+        auto const fill = [&](long const firstWord, long const lastWord) {
+            long triple = firstWord * TRIPLES_PER_WORD;
+            long const lastTriple = min(cTriples, lastWord * TRIPLES_PER_WORD);
+            if(triple >= lastTriple)
+                return;
+
+            // Decode the first triple and enumerate the subsequent ones in order
+            auto [i, j, k] = decode(triple);
+            for(; triple < lastTriple; triple++) {
+                int const sign = VectorSpace::orient(coordinates[i], coordinates[j], coordinates[k]);
+                uint64_t const code = sign > 0 ? POSITIVE : sign < 0 ? NEGATIVE : COLLINEAR;
+                words[triple / TRIPLES_PER_WORD] |= code << (2 * (triple % TRIPLES_PER_WORD));
+
+                if(++i == j) {
+                    i = 0;
+                    if(++j == k) {
+                        j = 1;
+                        k += 1;
+                    }
+                }
+            }
+        };
+
+        vector<thread> workers;
+        for(int t=0; t<cThreads; t++)
+            workers.emplace_back(fill, t * chunk, min(cWords, (t + 1) * chunk));
+        for(auto &worker : workers)
+            worker.join();
+
+        buildTime = duration_cast<milliseconds>(high_resolution_clock::now() - start).count();
+    }
+
+    [[nodiscard]] bool isEnabled() const {
+        return !words.empty();
+    }
+
+    [[nodiscard]] size_t bytes() const {
+        return words.size() * sizeof(uint64_t);
+    }
+
+    /**
+     * Looks up the orientation of three distinct points.
+     * @return The signum as in VectorSpace::orient.
+     */
+    [[nodiscard]] int orient(int a, int b, int c) const {
+        // Sorting the triple flips the orientation with every exchange
+        bool flipped = false;
+        if(a > b) { swap(a, b); flipped = !flipped; }
+        if(b > c) { swap(b, c); flipped = !flipped; }
+        if(a > b) { swap(a, b); flipped = !flipped; }
+
+        long const triple = choose3(c) + choose2(b) + a;
+        uint64_t const code = (words[triple / TRIPLES_PER_WORD] >> (2 * (triple % TRIPLES_PER_WORD))) & 3;
+        int const sign = code == POSITIVE ? 1 : code == NEGATIVE ? -1 : 0;
+        return flipped ? -sign : sign;
+    }
+
+    /**
+     * Decides a cross of two edges between pairwise distinct points.
+     * @return 1 for a proper cross, 0 for none or -1 if a collinear triple requires the full evaluation.
+     */
+    [[nodiscard]] int cross(int const aStart, int const aEnd, int const bStart, int const bEnd) const {
+        int const orientABC = orient(aStart, aEnd, bStart);
+        int const orientABD = orient(aStart, aEnd, bEnd);
+        if(orientABC == 0 || orientABD == 0)
+            return -1;
+
+        // Neither segment can touch the other if one is strictly on one side
+        if(orientABC == orientABD)
+            return 0;
+
+        int const orientCDA = orient(bStart, bEnd, aStart);
+        int const orientCDB = orient(bStart, bEnd, aEnd);
+        if(orientCDA == 0 || orientCDB == 0)
+            return -1;
+
+        return orientCDA != orientCDB;
+    }
+
+private:
+    static constexpr long TRIPLES_PER_WORD = 32;
+    static constexpr uint64_t COLLINEAR = 0;
+    static constexpr uint64_t POSITIVE = 1;
+    static constexpr uint64_t NEGATIVE = 2;
+
+    vector<uint64_t> words;
+
+    static long choose2(long const n) {
+        return n * (n - 1) / 2;
+    }
+
+    static long choose3(long const n) {
+        return n * (n - 1) * (n - 2) / 6;
+    }
+
+    /**
+     * Finds the triple i < j < k at a position of the combinatorial number system.
+     */
+    static tuple<int, int, int> decode(long triple) {
+        long k = 2;
+        while(choose3(k + 1) <= triple)
+            k++;
+        triple -= choose3(k);
+
+        long j = 1;
+        while(choose2(j + 1) <= triple)
+            j++;
+        triple -= choose2(j);
+
+        return {static_cast<int>(triple), static_cast<int>(j), static_cast<int>(k)};
+    }
+};
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef PROJECT_RADIAL_SWEEP_H
+#define PROJECT_RADIAL_SWEEP_H
+
+#include "dependencies.h"
+
+using namespace std;
+
+
+class RadialSweep {
+public:
+    /**
+     * Prepares the evaluation of relocations for a fixed vertex. The PSE must not be modified during the lifetime.
+     * @param emb The PSE.
+     * @param vertexId ID of the vertex to be relocated.
+     * @param cWorkers Number of threads evaluating concurrently, each with its own buffers.
+     */
+    RadialSweep(PSE const &emb, int const vertexId, int const cWorkers = 1)
+            : emb(emb), vertexId(vertexId), penalty(emb.penalty), exact(emb.gamma.isOnGrid()),
+              buffers(max(1, cWorkers)) {
+
+        for(int const neighbourId : emb.gamma.getNeighbours(vertexId)) {
+            ends.push_back(emb.gamma.getVertex(neighbourId).pos);
+            reversed.push_back(emb.gamma.getEdge(vertexId, neighbourId).aVertexId != vertexId);
+        }
+
+        // Only edges apart from the star are fixed
+        for(Edge const &edge : emb.gamma.edges())
+            if(edge.aVertexId != vertexId && edge.bVertexId != vertexId)
+                others.emplace_back(emb.gamma.getVertex(edge.aVertexId).pos, emb.gamma.getVertex(edge.bVertexId).pos);
+
+        for(Buffers &buffer : buffers) {
+            buffer.angles.reserve(ends.size());
+            buffer.coinciding.reserve(ends.size());
+        }
+
+        // Continuous positions are evaluated by the PSE instead
+        if(exact)
+            current = starCrossings(emb.gamma.getVertex(vertexId).pos);
+    }
+
+    /**
+     * Calculates the exact score change of moveOrSwap for the vertex.
+     * Free points are evaluated by the sweep if all vertices are on the grid, occupied points as exchange.
+     * @param pointId ID of the target.
+     * @param worker Index of the evaluating thread.
+     */
+    [[nodiscard]] long delta(int const pointId, int const worker = 0) const {
+        Point const &point = emb.points[pointId];
+        if(point.isOccupied())
+            return emb.deltaSwap(vertexId, point.occupierId);
+        if(!exact)
+            return emb.deltaMove(vertexId, pointId);
+        return starCrossings(point.pos, worker) - current;
+    }
+
+    /**
+     * Determines the candidate with the lowest score change among every cWorkers-th candidate from worker on.
+     * @param candidates IDs of the target points.
+     * @param worker Index of the evaluating thread.
+     * @param cWorkers Number of threads sharing the candidates.
+     * @return The lowest score change and the corresponding point (or -1 without candidates).
+     */
+    [[nodiscard]] pair<long, int> best(vector<int> const &candidates, int const worker = 0, int const cWorkers = 1) const {
+        pair<long, int> best = {numeric_limits<long>::max(), -1};
+        for(size_t i=worker; i<candidates.size(); i+=cWorkers)
+            best = min(best, {delta(candidates[i], worker), candidates[i]});
+        return best;
+    }
+
+    /**
+     * Sums the penalties of the vertex's edges when the vertex is located at the center.
+     * Each other edge spans an angular interval of less than pi around the center, so only the star edges whose
+     * angles fall into this interval can touch it. These are found by binary search in the sorted star angles.
+     * @param center Assumed position of the vertex.
+     * @param worker Index of the evaluating thread.
+     */
+    [[nodiscard]] long starCrossings(Position const &center, int const worker = 0) const {
+        int const cEnds = static_cast<int>(ends.size());
+        long score = 0;
+
+        // Sort the star's ends angularly around the center
+        vector<pair<double, int>> &angles = buffers[worker].angles;
+        vector<int> &coinciding = buffers[worker].coinciding;
+        angles.clear();
+        coinciding.clear();
+        for(int i=0; i<cEnds; i++) {
+            if(ends[i] == center)
+                coinciding.push_back(i);
+            else angles.emplace_back(angle(center, ends[i]), i);
+        }
+        sort(angles.begin(), angles.end());
+
+        for(auto const &[start, end] : others) {
+            // Degenerated edges reaching along the center are checked against the whole star
+            double const det = (start.x - center.x) * (end.y - center.y) - (start.y - center.y) * (end.x - center.x);
+            if(det == 0) {
+                for(int i=0; i<cEnds; i++)
+                    score += eval(center, i, start, end);
+                continue;
+            }
+
+            // The interval runs counterclockwise from low to high
+            double low = angle(center, start);
+            double high = angle(center, end);
+            if(det < 0)
+                swap(low, high);
+            if(high < low)
+                high += 2 * M_PI;
+
+            // Both bounds are widened to compensate for rounding, so the filter never misses a candidate
+            score += stab(angles, center, start, end, low - TOLERANCE, high + TOLERANCE);
+
+            for(int const i : coinciding)
+                score += eval(center, i, start, end);
+        }
+
+        // Star edges among each other
+        for(int i=0; i<cEnds; i++)
+            for(int j=i+1; j<cEnds; j++)
+                score += reversed[j] ? eval(center, i, ends[j], center) : eval(center, i, center, ends[j]);
+
+        return score;
+    }
+
+protected:
+    static constexpr double TOLERANCE = 1e-9;
+
+    PSE const &emb;
+    int vertexId;
+    int penalty;
+
+    // Are all positions integral? The sweep relies on exact predicates.
+    bool exact;
+
+    // Positions of the neighbours
+    vector<Position> ends;
+
+    // Does the edge to the neighbour start at the neighbour?
+    vector<bool> reversed;
+
+    // Positions of all edges not adjacent to the vertex
+    vector<pair<Position, Position>> others;
+
+    // Penalty of the star on the current position
+    long current = 0;
+
+    // Sorted angles of the star's ends and ends on the center, reused by the evaluations of a thread
+    struct Buffers {
+        vector<pair<double, int>> angles;
+        vector<int> coinciding;
+    };
+    mutable vector<Buffers> buffers;
+
+    /**
+     * Evaluates the star edges whose angles are within [low, high], where the interval may exceed [-pi, pi].
+     */
+    [[nodiscard]] long stab(vector<pair<double, int>> const &angles, Position const &center,
+                            Position const &start, Position const &end, double const low, double const high) const {
+        if(low < -M_PI)
+            return stab(angles, center, start, end, low + 2 * M_PI, M_PI) + stab(angles, center, start, end, -M_PI, high);
+        if(high > M_PI)
+            return stab(angles, center, start, end, low, M_PI) + stab(angles, center, start, end, -M_PI, high - 2 * M_PI);
+
+        long score = 0;
+        auto it = lower_bound(angles.begin(), angles.end(), pair{low, -1});
+        for(; it != angles.end() && it->first <= high; ++it)
+            score += eval(center, it->second, start, end);
+        return score;
+    }
+
+    /**
+     * Evaluates a star edge against a segment. The star edge keeps the orientation of the edge in the drawing,
+     * since evalSegments is not symmetric for degenerated segments.
+     */
+    [[nodiscard]] long eval(Position const &center, int const i, Position const &start, Position const &end) const {
+        Coordinate const centerCoord = VectorSpace::toCoordinate(center);
+        Coordinate const endCoord = VectorSpace::toCoordinate(ends[i]);
+        Coordinate const startCoord = VectorSpace::toCoordinate(start);
+        Coordinate const otherEndCoord = VectorSpace::toCoordinate(end);
+        if(reversed[i])
+            return VectorSpace::evalSegments(endCoord, centerCoord, startCoord, otherEndCoord, penalty);
+        return VectorSpace::evalSegments(centerCoord, endCoord, startCoord, otherEndCoord, penalty);
+    }
+
+    static double angle(Position const &center, Position const &pos) {
+        return atan2(pos.y - center.y, pos.x - center.x);
+    }
+};
+
+#endif
@@ -14,6 +14,9 @@ class Strategy {
 public:
     static string confDir;
 
+    // Overrides the thread counts of all configurations if positive
+    static int threads;
+
     explicit Strategy() : conf({}) { }
     virtual ~Strategy() = default;
 
@@ -29,26 +32,47 @@ protected:
     json conf;
 
     /**
-     * Imports configurations from a specified JSON file.
+     * Imports configurations from a specified JSON file. Each file is parsed once per process, so long-running
+     * processes do not re-read the configurations for every run.
      * @param file Name of the configuration file.
      * @throws runtime_error if the file cannot be opened.
      */
     void importConfig(const string& file) {
-        ifstream inputFile(confDir + file);
-        if (!inputFile.is_open())
-            throw runtime_error("File is not existing.");
+        static mutex caching;
+        static unordered_map<string, json> cache;
+
+        string const path = confDir + file;
+        lock_guard guard(caching);
+        auto it = cache.find(path);
+        if (it == cache.end()) {
+            ifstream inputFile(path);
+            if (!inputFile.is_open())
+                throw runtime_error("File is not existing.");
 
-        stringstream buffer;
-        buffer << inputFile.rdbuf();
-        string fileContent = buffer.str();
-        inputFile.close();
+            stringstream buffer;
+            buffer << inputFile.rdbuf();
+            inputFile.close();
+
+            it = cache.emplace(path, json::parse(buffer)).first;
+        }
+        conf = it->second;
+    }
 
-        conf = json::parse(buffer);
+    /**
+     * Determines the number of worker threads, where a global override precedes the configuration.
+     * @param configured Thread count of the configuration. All hardware threads are used if it is not positive.
+     */
+    static int threadCount(int const configured) {
+        int const cThreads = threads > 0 ? threads : configured;
+        if (cThreads < 1)
+            return static_cast<int>(max(1u, thread::hardware_concurrency()));
+        return cThreads;
     }
 };
 
 // Usually overwritten by main
 string Strategy::confDir = "../config/";
+int Strategy::threads = 0;
 
 
 class Executor {
@@ -58,8 +82,8 @@ public:
     PSE emb;
     InputOutput IO;
 
-    // Maximal time consumption in minutes
-    long maxTime = 50;
+    // Maximal time consumption in minutes, may be fractional
+    double maxTime = 50;
 
     // Current iteration
     long cIter = 0;
@@ -67,6 +91,12 @@ public:
     // Timestamp of initialization
     time_point<high_resolution_clock> initTime;
 
+    // Saved scores with the consumed time in ms
+    vector<pair<long, long>> progress;
+
+    // Name of the running strategy
+    string strategyName;
+
     /**
      * @param filePath The path to the initial drawing.
      * @param inputOutput InputOutput for File-IO.
@@ -74,25 +104,53 @@ public:
     explicit Executor(const string& filePath, InputOutput inputOutput)
             : initTime(high_resolution_clock::now()), IO(std::move(inputOutput)) {
 
-        emb = IO.load(filePath);
+        // Telemetry covers the executor from its construction
+        Telemetry::local().reset();
+        {
+            TELEMETRY_PHASE(load);
+            emb = IO.load(filePath);
+        }
+
         filesystem::path pathObj(filePath);
         if (pathObj.extension() == ".json")
             name = pathObj.stem().string();
         else name = filePath;
     }
 
+    /**
+     * @param name Name of the instance.
+     * @param initial The initial drawing, e.g., a generated one.
+     * @param inputOutput InputOutput for File-IO.
+     */
+    Executor(string name, PSE initial, InputOutput inputOutput)
+            : name(std::move(name)), emb(std::move(initial)), IO(std::move(inputOutput)),
+              initTime(high_resolution_clock::now()) {
+
+        Telemetry::local().reset();
+    }
+
+    /**
+     * Makes the random values of the executing thread reproducible. The seed is combined with the instance's name,
+     * so each Executor of a run draws its own sequence.
+     * @param seed The seed of the run.
+     */
+    void reseed(uint64_t const seed) const {
+        seedThread(seed ^ hash<string>{}(name));
+    }
+
     /**
      * Runs the given strategy on the loaded PSE and saves the results.
      * @param strategy Strategy to run.
      * @return Optimized PSE.
      */
     PSE run(Strategy& strategy) {
-        string strategyName = typeid(strategy).name();
-        regex const digits("^\\d+");
-        strategyName = regex_replace(strategyName, digits, "");
+        strategyName = readableName(typeid(strategy).name());
 
         // Execute and save the results
-        emb = strategy.run(*this);
+        {
+            TELEMETRY_PHASE(strategies);
+            emb = strategy.run(*this);
+        }
         long const score = emb.score();
 
         {
@@ -106,9 +164,29 @@ public:
 
         // Only keep the final drawing
         save(score, emb, 0);
+        trace(score, score, nullopt, -1, true);
+#ifdef TELEMETRY
+        exportTelemetry();
+#endif
         return emb;
     }
 
+    /**
+     * Writes the telemetry of the executing thread and its finished workers next to the output.
+     * @throws runtime_error if the file cannot be opened.
+     */
+    void exportTelemetry() const {
+        json data = Telemetry::local().toJson();
+        data["name"] = name;
+        data["totalMs"] = consumed<milliseconds>();
+        data["iterations"] = cIter;
+
+        ofstream file(IO.outputDir + name + "-telemetry.json");
+        if (!file.is_open())
+            throw runtime_error("Telemetry file cannot be opened.");
+        file << data.dump(4) << endl;
+    }
+
     /**
      * Saves an interim version of the PSE.
      * Keeps the specified number of best results so far and removes the others.
@@ -117,6 +195,9 @@ public:
      * @param keepOld Number of interim results to keep.
      */
     void save(long const &score, PSE &toSave, int keepOld) {
+        TELEMETRY_PHASE(save);
+        TELEMETRY_COUNT(saves);
+
         // Remove the worst file (usually only one iteration)
         while(interimScores.size() > keepOld) {
             try {
@@ -128,10 +209,73 @@ public:
         }
 
         interimScores.emplace(score);
+        progress.emplace_back(consumed<milliseconds>(), score);
         IO.save(toSave,  name + "-" + (to_string(score)) + ".json");
     }
 
-    [[nodiscard]] bool inTime() const { return consumed<minutes>() < maxTime; }
+    /**
+     * Writes a convergence trace as JSON lines next to the output. Each line is a sample of the progress.
+     * @param interval Minimal time between two samples in ms.
+     */
+    void enableTrace(long const interval) {
+        traceInterval = interval;
+        traceWriter = make_unique<TraceWriter>(IO.outputDir + name + "-trace.jsonl");
+    }
+
+    /**
+     * Samples the progress of the running strategy for the convergence trace. Only writes a line once the sampling
+     * interval has passed since the last one. Unknown values are omitted.
+     * @param current Current score or -1.
+     * @param best Best score of the strategy or -1.
+     * @param temp Current temperature if the strategy has one.
+     * @param cAccepted Accepted proposals of the strategy or -1, so the acceptance rate follows from the iterations.
+     * @param force Writes the line regardless of the interval.
+     */
+    void trace(long const current, long const best, optional<double> const temp = nullopt, long const cAccepted = -1,
+               bool const force = false) {
+        if (!traceWriter)
+            return;
+
+        long const now = consumed<milliseconds>();
+        if (now < nextTrace && !force)
+            return;
+
+        json line = {{"ms", now}, {"strategy", strategyName}, {"iteration", cIter}};
+        if (current >= 0)
+            line["current"] = current;
+        if (best >= 0)
+            line["best"] = best;
+        if (temp)
+            line["temperature"] = *temp;
+
+        long const cSampled = cIter - tracedIter;
+        if (cAccepted >= 0 && cSampled > 0 && cAccepted >= tracedAccepted)
+            line["acceptance"] = static_cast<double>(cAccepted - tracedAccepted) / static_cast<double>(cSampled);
+        if (now > tracedTime)
+            line["movesPerSec"] = static_cast<double>(cSampled) * 1000.0 / static_cast<double>(now - tracedTime);
+
+        traceWriter->push(line.dump());
+        nextTrace = now + traceInterval;
+        tracedTime = now;
+        tracedIter = cIter;
+        tracedAccepted = max(0L, cAccepted);
+    }
+
+    /**
+     * Records the proposals of the strategies as binary move trace next to the output, see MoveTrace.
+     */
+    void enableRecording() {
+        moveRecorder = make_unique<MoveRecorder>(IO.outputDir + name + "-moves.bin");
+    }
+
+    /**
+     * @return The recorder of the proposals or nullptr if recording is disabled.
+     */
+    [[nodiscard]] MoveRecorder *recorder() const {
+        return moveRecorder.get();
+    }
+
+    [[nodiscard]] bool inTime() const { return static_cast<double>(consumed<milliseconds>()) < maxTime * 60000; }
 
     /**
      * Calculates the time consumed since the initialization.
@@ -145,6 +289,30 @@ public:
 
 protected:
     priority_queue<long> interimScores;
+
+    // Convergence trace, only written if enabled
+    unique_ptr<TraceWriter> traceWriter;
+    long traceInterval = 0;
+    long nextTrace = 0;
+
+    // State of the last sample
+    long tracedTime = 0;
+    long tracedIter = 0;
+    long tracedAccepted = 0;
+
+    // Recorder of the proposals, only present if enabled
+    unique_ptr<MoveRecorder> moveRecorder;
+
+    /**
+     * Demangles a class name, e.g., "18SimulatedAnnealingI10RandomWalk15CoolExponentialE" as
+     * "SimulatedAnnealing<RandomWalk, CoolExponential>". Names that cannot be demangled are returned unchanged.
+     * @param mangled Name as provided by typeid.
+     */
+    static string readableName(char const *mangled) {
+        int status = 0;
+        unique_ptr<char, void (*)(void *)> const demangled(abi::__cxa_demangle(mangled, nullptr, nullptr, &status), free);
+        return status == 0 && demangled != nullptr ? string(demangled.get()) : string(mangled);
+    }
 };
 
 PSE Strategy::run(Executor &exec) {
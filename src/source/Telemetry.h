@@ -0,0 +1,150 @@
+#ifndef PROJECT_TELEMETRY_H
+#define PROJECT_TELEMETRY_H
+
+#include "dependencies.h"
+
+using namespace std;
+using namespace chrono;
+using namespace nlohmann;
+
+
+/**
+ * Per-thread counters and phase timers of the hot paths. Only the macros below record data, which are compiled out
+ * without the build option TELEMETRY. Worker threads report to the thread that spawned them once they terminate.
+ */
+class Telemetry {
+public:
+    enum Counter {
+        evalDisjoint = 0, evalCrossing = 1, evalTouching = 2,
+        crossByTable = 3, crossOnGrid = 4, crossContinuous = 5,
+        trackedMoves = 6, accepted = 7, rejected = 8, saves = 9, randomDraws = 10,
+        cCounters = 11
+    };
+
+    // Phases are inclusive, e.g., pen is also part of the strategies
+    enum Phase {load = 0, milieu = 1, prepareTracker = 2, pen = 3, save = 4, strategies = 5, cPhases = 6};
+
+    Telemetry() = default;
+    Telemetry(Telemetry const &) = delete;
+    Telemetry &operator=(Telemetry const &) = delete;
+
+    ~Telemetry() {
+        if(owner != nullptr)
+            owner->merge(*this);
+    }
+
+    /**
+     * Telemetry of the executing thread.
+     */
+    static Telemetry &local() {
+        thread_local Telemetry telemetry;
+        return telemetry;
+    }
+
+    void count(Counter const counter) {
+        counts[counter] += 1;
+    }
+
+    /**
+     * Counts the outcome class of a segment evaluation.
+     * @param result Result of evalSegments.
+     * @param pen Penalty value of the evaluation.
+     */
+    void countOutcome(long const result, int const pen) {
+        if(result == 0)
+            counts[evalDisjoint] += 1;
+        else if(result == pen)
+            counts[evalTouching] += 1;
+        else counts[evalCrossing] += 1;
+    }
+
+    /**
+     * Merges the data of this thread into another telemetry once this thread terminates.
+     * @param target Telemetry of the spawning thread.
+     */
+    void reportTo(Telemetry *target) {
+        owner = target;
+    }
+
+    void reset() {
+        lock_guard guard(merging);
+        counts.fill(0);
+        nanos.fill(0);
+        calls.fill(0);
+    }
+
+    [[nodiscard]] json toJson() {
+        static array<char const *, cCounters> constexpr counterNames = {
+            "evalDisjoint", "evalCrossing", "evalTouching", "crossByTable", "crossOnGrid", "crossContinuous",
+            "trackedMoves", "accepted", "rejected", "saves", "randomDraws"
+        };
+        static array<char const *, cPhases> constexpr phaseNames = {
+            "load", "milieu", "prepareTracker", "pen", "save", "strategies"
+        };
+
+        lock_guard guard(merging);
+        json data;
+        for(int i=0; i<cCounters; i++)
+            data["counters"][counterNames[i]] = counts[i];
+        for(int i=0; i<cPhases; i++)
+            data["phases"][phaseNames[i]] = {{"ms", static_cast<double>(nanos[i]) / 1e6}, {"calls", calls[i]}};
+        return data;
+    }
+
+    /**
+     * Measures a phase from construction to destruction.
+     */
+    class Timer {
+    public:
+        explicit Timer(Phase const phase) : phase(phase), start(steady_clock::now()) { }
+
+        ~Timer() {
+            Telemetry &telemetry = local();
+            telemetry.nanos[phase] += duration_cast<nanoseconds>(steady_clock::now() - start).count();
+            telemetry.calls[phase] += 1;
+        }
+
+        Timer(Timer const &) = delete;
+        Timer &operator=(Timer const &) = delete;
+
+    private:
+        Phase phase;
+        time_point<steady_clock> start;
+    };
+
+private:
+    array<long, cCounters> counts{};
+    array<long, cPhases> nanos{};
+    array<long, cPhases> calls{};
+
+    Telemetry *owner = nullptr;
+
+    // Several workers may terminate at once
+    mutex merging;
+
+    void merge(Telemetry const &other) {
+        lock_guard guard(merging);
+        for(int i=0; i<cCounters; i++)
+            counts[i] += other.counts[i];
+        for(int i=0; i<cPhases; i++) {
+            nanos[i] += other.nanos[i];
+            calls[i] += other.calls[i];
+        }
+    }
+};
+
+#ifdef TELEMETRY
+#define TELEMETRY_COUNT(counter) Telemetry::local().count(Telemetry::counter)
+#define TELEMETRY_OUTCOME(result, pen) Telemetry::local().countOutcome(result, pen)
+#define TELEMETRY_PHASE(phase) Telemetry::Timer const phase##Timer(Telemetry::phase)
+#define TELEMETRY_SPAWNER Telemetry *const telemetryOwner = &Telemetry::local()
+#define TELEMETRY_WORKER Telemetry::local().reportTo(telemetryOwner)
+#else
+#define TELEMETRY_COUNT(counter)
+#define TELEMETRY_OUTCOME(result, pen)
+#define TELEMETRY_PHASE(phase)
+#define TELEMETRY_SPAWNER
+#define TELEMETRY_WORKER
+#endif
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef PROJECT_TRACE_H
+#define PROJECT_TRACE_H
+
+#include "dependencies.h"
+
+using namespace std;
+using namespace chrono;
+
+
+/**
+ * Appends lines to a file on a background thread. Callers only hand the lines over, so slow disks never stall the
+ * optimization. The pending lines are written periodically and on destruction.
+ */
+class TraceWriter {
+public:
+    /**
+     * @param path Path of the file, which is truncated.
+     * @throws runtime_error if the file cannot be opened.
+     */
+    explicit TraceWriter(string const &path) : file(path, ios::trunc) {
+        if (!file.is_open())
+            throw runtime_error("Trace file cannot be opened: " + path);
+        worker = thread([this]() { drain(); });
+    }
+
+    ~TraceWriter() {
+        {
+            lock_guard guard(pendingMutex);
+            stopping = true;
+        }
+        wakeup.notify_one();
+        worker.join();
+    }
+
+    TraceWriter(TraceWriter const &) = delete;
+    TraceWriter &operator=(TraceWriter const &) = delete;
+
+    /**
+     * Hands a line over to the writer.
+     * @param line Line without the trailing line break.
+     */
+    void push(string line) {
+        lock_guard guard(pendingMutex);
+        pending.push_back(std::move(line));
+    }
+
+private:
+    static constexpr milliseconds FLUSH_INTERVAL = milliseconds(200);
+
+    ofstream file;
+    thread worker;
+
+    mutex pendingMutex;
+    condition_variable wakeup;
+    vector<string> pending;
+    bool stopping = false;
+
+    void drain() {
+        vector<string> lines;
+        bool done = false;
+        while (!done) {
+            {
+                unique_lock lock(pendingMutex);
+                wakeup.wait_for(lock, FLUSH_INTERVAL, [this]() { return stopping; });
+                lines.swap(pending);
+                done = stopping;
+            }
+
+            for (string const &line : lines)
+                file << line << '\n';
+            file.flush();
+            lines.clear();
+        }
+    }
+};
+
+#endif
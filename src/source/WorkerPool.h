@@ -0,0 +1,109 @@
+#ifndef PROJECT_WORKER_POOL_H
+#define PROJECT_WORKER_POOL_H
+
+#include "dependencies.h"
+
+using namespace std;
+
+
+/**
+ * Persistent threads that run a task on all workers at once, where the calling thread is worker 0. Unlike threads
+ * spawned per task, short tasks are not dominated by the thread startup.
+ */
+class WorkerPool {
+public:
+    /**
+     * @param cWorkers Number of workers including the calling thread.
+     */
+    explicit WorkerPool(int const cWorkers) : cWorkers(max(1, cWorkers)) {
+        vector<uint64_t> const seeds = drawSeeds(this->cWorkers);
+        for(int worker=1; worker<this->cWorkers; worker++)
+            threads.emplace_back([this, worker, seed = seeds[worker]]() {
+                TELEMETRY_WORKER;
+                seedThread(seed);
+                work(worker);
+            });
+    }
+
+    ~WorkerPool() {
+        {
+            lock_guard guard(taskMutex);
+            stopping = true;
+        }
+        started.notify_all();
+        for(auto &thread : threads)
+            thread.join();
+    }
+
+    WorkerPool(WorkerPool const &) = delete;
+    WorkerPool &operator=(WorkerPool const &) = delete;
+
+    [[nodiscard]] int size() const {
+        return cWorkers;
+    }
+
+    /**
+     * Runs a task on every worker and waits until all of them are done.
+     * @param task Called with the index of the worker in [0, size()).
+     */
+    void run(function<void(int)> const &task) {
+        if(cWorkers == 1) {
+            task(0);
+            return;
+        }
+
+        {
+            lock_guard guard(taskMutex);
+            current = &task;
+            cPending = cWorkers - 1;
+            generation += 1;
+        }
+        started.notify_all();
+
+        task(0);
+
+        unique_lock lock(taskMutex);
+        finished.wait(lock, [this]() { return cPending == 0; });
+        current = nullptr;
+    }
+
+private:
+    int const cWorkers;
+    vector<thread> threads;
+
+    // Workers merge their telemetry into the creating thread
+    Telemetry *const telemetryOwner = &Telemetry::local();
+
+    mutex taskMutex;
+    condition_variable started;
+    condition_variable finished;
+    function<void(int)> const *current = nullptr;
+    long generation = 0;
+    int cPending = 0;
+    bool stopping = false;
+
+    void work(int const worker) {
+        long seen = 0;
+        while(true) {
+            function<void(int)> const *task;
+            {
+                unique_lock lock(taskMutex);
+                started.wait(lock, [&]() { return stopping || generation != seen; });
+                if(stopping)
+                    return;
+                seen = generation;
+                task = current;
+            }
+
+            (*task)(worker);
+
+            {
+                lock_guard guard(taskMutex);
+                cPending -= 1;
+            }
+            finished.notify_one();
+        }
+    }
+};
+
+#endif
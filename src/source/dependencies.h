@@ -3,6 +3,7 @@
 
 #include <utility>
 #include <unordered_set>
+#include <unordered_map>
 #include <vector>
 #include <map>
 #include <string>
@@ -14,12 +15,24 @@
 #include <cmath>
 #include <set>
 #include <queue>
+#include <deque>
+#include <list>
 #include <random>
 #include <mutex>
+#include <condition_variable>
+#include <future>
 #include <thread>
 #include <cstdio>
 #include <regex>
 #include <algorithm>
+#include <memory>
+#include <atomic>
+#include <numeric>
+#include <optional>
+#include <array>
+#include <new>
+#include <cstdlib>
+#include <cxxabi.h>
 
 #include "external/nlohmann/json.hpp"
 #include "external/cxxopts/cxxopts.hpp"
@@ -30,10 +43,17 @@ inline mutex console;
 
 inline constexpr double EPS = 1e-9;
 
+#include "Allocations.h"
+#include "Telemetry.h"
 #include "Helpers.h"
 #include "Drawing.h"
+#include "OrientationTable.h"
 #include "Embedding.h"
+#include "RadialSweep.h"
+#include "MoveTrace.h"
 #include "InputOutput.h"
+#include "Trace.h"
+#include "WorkerPool.h"
 #include "Strategy.h"
 
 inline auto randPercent = NumRandomizer(0, 99);
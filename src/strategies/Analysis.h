@@ -17,7 +17,7 @@ public:
         cout << endl;
         cout << "Analysis report of " << exec.name << endl;
         cout << "|V| = " << exec.emb.gamma.vertices.size() << endl;
-        cout << "|E| = " << exec.emb.gamma.edges.size() << endl;
+        cout << "|E| = " << exec.emb.gamma.edges().size() << endl;
         cout << "|P| = " << exec.emb.points.size() << endl;
 
         double avgDeg = 0;
@@ -34,6 +34,26 @@ public:
         cout << "maxDegree = " << maxDeg << endl;
         cout << "avgDegree = " << avgDeg << endl;
         cout << "size = " << exec.emb.width << "x" << exec.emb.height << endl;
+
+        // Share of edge pairs that the crossing kernels skip by their bounding boxes
+        long cPairs = 0;
+        long cRejected = 0;
+        int const cEdges = static_cast<int>(exec.emb.gamma.edges().size());
+        for(int aEdgeId=0; aEdgeId<cEdges; aEdgeId++) {
+            Box const box = exec.emb.gamma.boxOf(aEdgeId);
+            for(int bEdgeId=aEdgeId+1; bEdgeId<cEdges; bEdgeId++)
+                cRejected += !box.overlaps(exec.emb.gamma.boxOf(bEdgeId));
+            cPairs += cEdges - aEdgeId - 1;
+        }
+        long cCollinear = 0;
+        for(Point const &point : exec.emb.points)
+            cCollinear += exec.emb.isCollinear(point.id);
+        cout << "collinearPoints = " << cCollinear << endl;
+        OrientationTable const &orientations = exec.emb.getOrientations();
+        if(orientations.isEnabled())
+            cout << "orientationTable = " << orientations.bytes() / 1024 << "KiB in " << orientations.buildTime << "ms" << endl;
+        else cout << "orientationTable = disabled" << endl;
+        cout << "boxRejection = " << static_cast<double>(cRejected) / static_cast<double>(max(1L, cPairs)) << endl;
         cout << endl;
 
         console.unlock();
@@ -0,0 +1,348 @@
+#ifndef PROJECT_BATCH_SERVER_H
+#define PROJECT_BATCH_SERVER_H
+
+#include "../source/dependencies.h"
+#include "Registry.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace chrono;
+using namespace nlohmann;
+namespace fs = std::filesystem;
+
+
+/**
+ * Destination of result lines, i.e., a stream or a socket connection, which is closed with the last reference.
+ */
+class ResultSink {
+public:
+    explicit ResultSink(ostream &stream) : stream(&stream) { }
+
+    explicit ResultSink(int const socket) : socket(socket) { }
+
+    ~ResultSink() {
+        if (socket >= 0)
+            ::close(socket);
+    }
+
+    ResultSink(ResultSink const &) = delete;
+    ResultSink &operator=(ResultSink const &) = delete;
+
+    /**
+     * Writes a line, where lines of concurrent jobs are never interleaved.
+     * @param line Line without the trailing line break.
+     */
+    void send(string const &line) {
+        lock_guard guard(writing);
+        if (stream != nullptr) {
+            *stream << line << endl;
+            return;
+        }
+
+        // Clients may disconnect early, which must not raise SIGPIPE
+        string const data = line + '\n';
+        size_t sent = 0;
+        while (sent < data.size()) {
+            ssize_t const cSent = ::send(socket, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (cSent <= 0)
+                return;
+            sent += static_cast<size_t>(cSent);
+        }
+    }
+
+private:
+    ostream *stream = nullptr;
+    int socket = -1;
+    mutex writing;
+};
+
+
+/**
+ * Long-running mode, which reads one JSON job per line and answers with one JSON result line per job.
+ * A job names an "input" file, a "strategy" sequence and an "output" directory, optionally a "time" in minutes,
+ * a "seed", a "trace" interval and an "id", which is echoed. Jobs run on a bounded pool of workers, while the recently
+ * used instances stay cached across jobs until their files change. The configurations are cached by
+ * Strategy::importConfig anyway.
+ */
+class BatchServer {
+public:
+    /**
+     * @param cWorkers Number of jobs running at once.
+     * @param defaultTime Time limit in minutes of jobs without one.
+     * @param renumber Renumber the loaded instances along a Hilbert curve.
+     * @param cCached Number of instances kept in the cache, where the least recently used one is evicted first.
+     */
+    BatchServer(int const cWorkers, double const defaultTime, bool const renumber, int const cCached)
+            : defaultTime(defaultTime), renumber(renumber), capacity(2 * static_cast<size_t>(cWorkers)),
+              cCached(static_cast<size_t>(max(1, cCached))) {
+
+        for (int i=0; i<cWorkers; i++)
+            workers.emplace_back([this]() { work(); });
+    }
+
+    /**
+     * Finishes all submitted jobs.
+     */
+    ~BatchServer() {
+        {
+            lock_guard guard(queueMutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (auto &worker : workers)
+            worker.join();
+    }
+
+    BatchServer(BatchServer const &) = delete;
+    BatchServer &operator=(BatchServer const &) = delete;
+
+    /**
+     * Reads jobs from a stream until its end.
+     * @param input The stream of jobs.
+     * @param sink Destination of the results.
+     */
+    void serve(istream &input, shared_ptr<ResultSink> const &sink) {
+        string line;
+        while (getline(input, line))
+            submit(line, sink);
+    }
+
+    /**
+     * Accepts connections on a local socket, each sending jobs and receiving their results. Never returns.
+     * @param path Path of the socket, which is replaced if it exists.
+     * @throws runtime_error if the socket cannot be opened.
+     */
+    [[noreturn]] void serve(string const &path) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(address.sun_path))
+            throw runtime_error("Socket path is too long: " + path);
+        copy(path.begin(), path.end(), address.sun_path);
+
+        int const listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        ::unlink(path.c_str());
+        if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0
+                || ::listen(listener, SOMAXCONN) < 0)
+            throw runtime_error("Socket cannot be opened: " + path);
+
+        while (true) {
+            int const connection = ::accept(listener, nullptr, nullptr);
+            if (connection < 0)
+                continue;
+
+            // The sink closes the connection once the reader and all of its jobs are done
+            thread([this, sink = make_shared<ResultSink>(connection), connection]() {
+                string pending;
+                char buffer[4096];
+                ssize_t cRead;
+                while ((cRead = ::recv(connection, buffer, sizeof(buffer), 0)) > 0) {
+                    pending.append(buffer, static_cast<size_t>(cRead));
+                    size_t end;
+                    while ((end = pending.find('\n')) != string::npos) {
+                        submit(pending.substr(0, end), sink);
+                        pending.erase(0, end + 1);
+                    }
+                }
+                if (!pending.empty())
+                    submit(pending, sink);
+            }).detach();
+        }
+    }
+
+private:
+    struct Job {
+        string line;
+        shared_ptr<ResultSink> sink;
+    };
+
+    /**
+     * Parsed instance with the InputOutput that loaded it, which keeps the original IDs of renumbered instances.
+     */
+    struct Instance {
+        PSE emb;
+        InputOutput IO;
+    };
+
+    /**
+     * Cached instance, which is valid as long as its file keeps the modification time and size of loading.
+     */
+    struct CacheEntry {
+        shared_future<shared_ptr<Instance const>> instance;
+        fs::file_time_type modified;
+        uintmax_t size;
+        long loadId;
+        list<string>::iterator used;
+    };
+
+    double defaultTime;
+    bool renumber;
+
+    // Number of the jobs started so far, which makes the names of their outputs unique
+    atomic<long> cJobs = 0;
+
+    // Readers block while the queue is full, so jobs are not read ahead of the workers
+    size_t capacity;
+    deque<Job> queue;
+    mutex queueMutex;
+    condition_variable available;
+    condition_variable space;
+    bool stopping = false;
+    vector<thread> workers;
+
+    // Instances by absolute path, loaded once even if several jobs ask at once
+    size_t cCached;
+    mutex cacheMutex;
+    unordered_map<string, CacheEntry> instances;
+
+    // Paths of the cached instances from the most to the least recently used one
+    list<string> recency;
+    long cLoads = 0;
+
+    void submit(string line, shared_ptr<ResultSink> const &sink) {
+        if (line.empty())
+            return;
+
+        unique_lock lock(queueMutex);
+        space.wait(lock, [this]() { return queue.size() < capacity; });
+        queue.push_back({std::move(line), sink});
+        lock.unlock();
+        available.notify_one();
+    }
+
+    void work() {
+        while (true) {
+            Job job;
+            {
+                unique_lock lock(queueMutex);
+                available.wait(lock, [this]() { return stopping || !queue.empty(); });
+                if (queue.empty())
+                    return;
+                job = std::move(queue.front());
+                queue.pop_front();
+            }
+            space.notify_one();
+            job.sink->send(execute(job.line).dump());
+        }
+    }
+
+    /**
+     * Runs a job and describes its result. Failures are reported instead of thrown, so one broken job does not
+     * terminate the server.
+     */
+    json execute(string const &line) {
+        json result;
+        try {
+            json const job = json::parse(line);
+            if (job.contains("id"))
+                result["id"] = job["id"];
+            for (char const *field : {"input", "strategy", "output"})
+                if (!job.contains(field))
+                    throw runtime_error(string("Missing field: ") + field);
+
+            string const path = fs::absolute(job["input"].get<string>()).lexically_normal().string();
+            string const output = fs::absolute(job["output"].get<string>()).string();
+            result["input"] = path;
+            result["strategy"] = job["strategy"];
+
+            bool cached = true;
+            shared_ptr<Instance const> const instance = load(path, output, cached);
+            result["cached"] = cached;
+
+            // Jobs on the same instance and output directory must not remove each other's interim results
+            long const number = cJobs.fetch_add(1) + 1;
+            result["job"] = number;
+            Executor exec(fs::path(path).stem().string() + "-job" + to_string(number), instance->emb,
+                          instance->IO.withOutput(output));
+            exec.maxTime = job.value("time", defaultTime);
+            if (job.contains("seed"))
+                exec.reseed(job["seed"].get<uint64_t>());
+            if (job.value("trace", 0L) > 0)
+                exec.enableTrace(job["trace"].get<long>());
+
+            runSequence(exec, job["strategy"].get<string>());
+
+            // Each strategy ends with saving the exactly scored drawing
+            long const score = exec.progress.empty() ? exec.emb.score() : exec.progress.back().second;
+            result["status"] = "ok";
+            result["score"] = score;
+            result["file"] = exec.IO.outputDir + exec.name + "-" + to_string(score) + ".json";
+            result["iterations"] = exec.cIter;
+            result["ms"] = exec.consumed<milliseconds>();
+        }
+        catch (exception const &e) {
+            result["status"] = "error";
+            result["error"] = e.what();
+        }
+        return result;
+    }
+
+    /**
+     * Retrieves a cached instance or loads it. Instances whose files were modified since are loaded again, and the
+     * least recently used ones are evicted beyond the capacity. Failed loads are not cached, so they can be retried.
+     * @param path Absolute path of the instance.
+     * @param output Output directory, which is required by InputOutput.
+     * @param cached Is set to false if this call loads the instance.
+     */
+    shared_ptr<Instance const> load(string const &path, string const &output, bool &cached) {
+        // Missing files are reported by loading them
+        error_code error;
+        fs::file_time_type const modified = fs::last_write_time(path, error);
+        uintmax_t const size = error ? 0 : fs::file_size(path, error);
+
+        promise<shared_ptr<Instance const>> loading;
+        shared_future<shared_ptr<Instance const>> future;
+        long loadId = 0;
+        {
+            lock_guard guard(cacheMutex);
+            auto const it = instances.find(path);
+            if (it != instances.end() && !error && it->second.modified == modified && it->second.size == size) {
+                future = it->second.instance;
+                recency.splice(recency.begin(), recency, it->second.used);
+            }
+            else {
+                if (it != instances.end()) {
+                    recency.erase(it->second.used);
+                    instances.erase(it);
+                }
+
+                // Jobs still running on an evicted instance keep it alive by their references
+                cached = false;
+                future = loading.get_future().share();
+                loadId = ++cLoads;
+                recency.push_front(path);
+                instances.emplace(path, CacheEntry{future, modified, size, loadId, recency.begin()});
+                while (instances.size() > cCached) {
+                    instances.erase(recency.back());
+                    recency.pop_back();
+                }
+            }
+        }
+
+        if (!cached) {
+            try {
+                fs::path const filePath(path);
+                InputOutput IO(filePath.parent_path().string(), output, renumber);
+                PSE emb = IO.load(filePath.filename().string());
+                loading.set_value(make_shared<Instance const>(Instance{std::move(emb), std::move(IO)}));
+            }
+            catch (...) {
+                {
+                    // The entry may already be evicted or replaced by a newer load
+                    lock_guard guard(cacheMutex);
+                    auto const it = instances.find(path);
+                    if (it != instances.end() && it->second.loadId == loadId) {
+                        recency.erase(it->second.used);
+                        instances.erase(it);
+                    }
+                }
+                loading.set_exception(current_exception());
+            }
+        }
+        return future.get();
+    }
+};
+
+#endif
@@ -0,0 +1,267 @@
+#ifndef PROJECT_BRANCH_AND_BOUND_H
+#define PROJECT_BRANCH_AND_BOUND_H
+
+#include "../source/dependencies.h"
+#include "Greedy.h"
+
+using namespace std;
+using namespace chrono;
+
+
+class BranchAndBound final : public Strategy {
+public:
+    explicit BranchAndBound() : Strategy() { }
+
+    /**
+     ********************
+     * Branch and Bound *
+     ********************
+     * Assigns the vertices one after another in degree-descending order. Crossings among the edges whose endpoints
+     * are both placed already form a lower bound, so a subtree is pruned once it reaches the incumbent.
+     */
+    PSE run(Executor &exec) override {
+        importConfig("bnb.json");
+
+        PSE &emb = exec.emb;
+        int const cVertices = static_cast<int>(emb.gamma.vertices.size());
+        int const cPoints = static_cast<int>(emb.points.size());
+        if(cVertices == 0 || cVertices > cPoints)
+            return emb;
+
+        // Seed the incumbent from a complete layout or from the greedy assignment
+        vector<int> seed = layoutOf(emb);
+        PSE base = emb;
+        if(seed.empty() || !conf["useExisting"]) {
+            base = Greedy::fastAssignment(emb);
+            seed = layoutOf(base);
+        }
+        bestLayout = seed;
+        incumbent = materialize(base, bestLayout).score();
+
+        // Higher degrees first, since their edges contribute to the bound early
+        order.resize(cVertices);
+        iota(order.begin(), order.end(), 0);
+        stable_sort(order.begin(), order.end(), [&emb](int const a, int const b) {
+            return emb.gamma.getVertex(a).deg > emb.gamma.getVertex(b).deg;
+        });
+
+        // Cache the neighbours that are placed before a vertex, including the vertex itself for a loop
+        vector<int> rank(cVertices);
+        for(int i=0; i<cVertices; i++)
+            rank[order[i]] = i;
+        placedNeighbours.assign(cVertices, {});
+        for(int i=0; i<cVertices; i++)
+            for(int const neighbourId : emb.gamma.getNeighbours(order[i]))
+                if(rank[neighbourId] <= i)
+                    placedNeighbours[i].push_back(neighbourId);
+
+        // Subtrees below the first vertex are distributed among the workers
+        int cThreads = threadCount(conf["threads"]);
+
+        nextBranch = 0;
+        aborted = false;
+        cSampled = 0;
+        startIter = exec.cIter;
+        vector<long> explored(cThreads, 0);
+        vector<uint64_t> const seeds = drawSeeds(cThreads);
+        TELEMETRY_SPAWNER;
+        vector<thread> workers;
+        for(int t=0; t<cThreads; t++)
+            workers.emplace_back([&, t]() {
+                TELEMETRY_WORKER;
+                seedThread(seeds[t]);
+                explored[t] = work(exec, base);
+            });
+        for(auto &worker : workers)
+            worker.join();
+
+        exec.cIter = startIter + accumulate(explored.begin(), explored.end(), 0L);
+
+        if(!aborted) {
+            lock_guard guard(console);
+            cout << endl << "Branch and bound proved optimality for " << exec.name << "." << endl;
+        }
+
+        return materialize(base, bestLayout);
+    }
+
+protected:
+    // Assignment order of the vertices
+    vector<int> order;
+
+    // Neighbours of order[i] that are placed before order[i], or order[i] itself for a loop
+    vector<vector<int>> placedNeighbours;
+
+    // Best known complete layout (point per vertex) and its score
+    vector<int> bestLayout;
+    atomic<long> incumbent = 0;
+    mutex incumbentLock;
+
+    atomic<int> nextBranch = 0;
+    atomic<bool> aborted = false;
+
+    // Nodes explored by all workers, sampled in steps of the clock checks, and the iterations before the search
+    atomic<long> cSampled = 0;
+    long startIter = 0;
+
+    struct SearchState {
+        // Point per vertex or -1
+        vector<int> pointOf;
+        vector<bool> used;
+
+        // Edges with both endpoints placed
+        vector<pair<int, int>> placedEdges;
+
+        // Explored nodes
+        long nodes = 0;
+    };
+
+    /**
+     * Pulls first-level branches until none are left.
+     * @param exec Helping Executor.
+     * @param base PSE providing the point set.
+     * @return Number of explored nodes.
+     */
+    long work(Executor &exec, PSE const &base) {
+        SearchState state;
+        state.pointOf.assign(base.gamma.vertices.size(), -1);
+        state.used.assign(base.points.size(), false);
+
+        int const cPoints = static_cast<int>(base.points.size());
+        for(int branch = nextBranch++; branch < cPoints && !aborted; branch = nextBranch++) {
+            state.pointOf[order[0]] = branch;
+            state.used[branch] = true;
+            descend(exec, base, state, 1, 0);
+            state.used[branch] = false;
+            state.pointOf[order[0]] = -1;
+        }
+        return state.nodes;
+    }
+
+    /**
+     * Places the vertex at the given depth on every free point and descends while the bound is below the incumbent.
+     * @param exec Helping Executor.
+     * @param base PSE providing the point set.
+     * @param state Search state of the worker.
+     * @param depth Number of placed vertices.
+     * @param bound Crossings among the placed edges.
+     */
+    void descend(Executor &exec, PSE const &base, SearchState &state, int const depth, long const bound) {
+        if(bound >= incumbent)
+            return;
+
+        // Checking the clock is too expensive for every node
+        if((++state.nodes & 0x3FF) == 0) {
+            if(!exec.inTime())
+                aborted = true;
+            sample(exec);
+        }
+        if(aborted)
+            return;
+
+        if(depth == static_cast<int>(order.size())) {
+            improve(exec, base, state.pointOf, bound);
+            return;
+        }
+
+        int const vertexId = order[depth];
+        vector<int> const &neighbours = placedNeighbours[depth];
+        size_t const cPlaced = state.placedEdges.size();
+
+        int const cPoints = static_cast<int>(base.points.size());
+        for(int pointId=0; pointId<cPoints; pointId++) {
+            if(state.used[pointId])
+                continue;
+
+            state.pointOf[vertexId] = pointId;
+            state.used[pointId] = true;
+
+            // Only the new edges change the bound
+            long delta = 0;
+            for(int const neighbourId : neighbours) {
+                pair<int, int> const edge = {vertexId, neighbourId};
+                for(auto const &placed : state.placedEdges)
+                    delta += cross(base, state.pointOf, edge, placed);
+                state.placedEdges.push_back(edge);
+            }
+
+            descend(exec, base, state, depth + 1, bound + delta);
+
+            state.placedEdges.resize(cPlaced);
+            state.used[pointId] = false;
+            state.pointOf[vertexId] = -1;
+        }
+    }
+
+    /**
+     * Traces the explored nodes of all workers and the incumbent. The executor is shared, so the workers take turns.
+     */
+    void sample(Executor &exec) {
+        long const cNodes = cSampled += 0x400;
+        lock_guard guard(incumbentLock);
+        exec.cIter = startIter + cNodes;
+        exec.trace(-1, incumbent);
+    }
+
+    /**
+     * Replaces the incumbent if the complete layout is still better.
+     */
+    void improve(Executor &exec, PSE const &base, vector<int> const &layout, long const score) {
+        lock_guard guard(incumbentLock);
+        if(score >= incumbent)
+            return;
+
+        incumbent = score;
+        bestLayout = layout;
+
+        PSE improved = materialize(base, bestLayout);
+        exec.save(score, improved, 2);
+    }
+
+    /**
+     * Evaluates a cross for two edges given by their vertices.
+     */
+    static long cross(PSE const &base, vector<int> const &pointOf, pair<int, int> const &aEdge, pair<int, int> const &bEdge) {
+        // Points are always on the grid
+        Coordinate const aStart = VectorSpace::toCoordinate(base.points[pointOf[aEdge.first]].pos);
+        Coordinate const aEnd = VectorSpace::toCoordinate(base.points[pointOf[aEdge.second]].pos);
+        Coordinate const bStart = VectorSpace::toCoordinate(base.points[pointOf[bEdge.first]].pos);
+        Coordinate const bEnd = VectorSpace::toCoordinate(base.points[pointOf[bEdge.second]].pos);
+        return VectorSpace::evalSegments(aStart, aEnd, bStart, bEnd, static_cast<int>(base.penalty));
+    }
+
+    /**
+     * Reads the point per vertex of a complete layout.
+     * @return Empty if a vertex is not on a point or two vertices share a point.
+     */
+    static vector<int> layoutOf(PSE const &emb) {
+        vector<int> layout;
+        vector<bool> used(emb.points.size(), false);
+
+        for(Vertex const &vertex : emb.gamma.vertices) {
+            int const pointId = emb.findPointOnPos(vertex.pos);
+            if(pointId == -1 || used[pointId])
+                return {};
+
+            used[pointId] = true;
+            layout.push_back(pointId);
+        }
+        return layout;
+    }
+
+    /**
+     * Moves all vertices of a PSE onto the points of a layout.
+     */
+    static PSE materialize(PSE emb, vector<int> const &layout) {
+        for(Point &point : emb.points)
+            point.release();
+        for(int vertexId=0; vertexId<static_cast<int>(layout.size()); vertexId++)
+            emb.moveToPoint(vertexId, layout[vertexId]);
+
+        // The untracked moves invalidate a tracker that the base may have prepared
+        emb.resetTracker();
+        return emb;
+    }
+};
+
+#endif
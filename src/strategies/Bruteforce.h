@@ -64,6 +64,7 @@ public:
             }
 
             exec.cIter++;
+            exec.trace(score, minScore);
         }
 
         return minEmb;
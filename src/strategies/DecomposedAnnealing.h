@@ -0,0 +1,206 @@
+#ifndef PROJECT_DECOMPOSED_ANNEALING_H
+#define PROJECT_DECOMPOSED_ANNEALING_H
+
+#include "../source/dependencies.h"
+#include "SimulatedAnnealing.h"
+#include "Greedy.h"
+
+using namespace std;
+
+
+/**
+ * Simulated annealing on one instance by several threads. The plane is partitioned into a grid of regions with equally
+ * many points, one per thread. During an epoch, each worker anneals the vertices in its region by random walks to the
+ * region's points, while all other vertices are fixed for it. Afterwards, the regions are merged, the global tracker is
+ * prepared again and the boundaries are shifted for the next epoch.
+ */
+template<typename Cooling>
+class DecomposedAnnealing final : public Strategy {
+public:
+    explicit DecomposedAnnealing() : Strategy() { }
+
+    PSE run(Executor &exec) override {
+        importConfig("SA.json");
+
+        AnnealingState state;
+        state.initTemp = conf["initTemp"];
+        state.expBase = conf["exponential"]["base"];
+        state.linFact = conf["linear"]["factor"];
+
+        json const &decomposition = conf["decomposition"];
+        int const cThreads = threadCount(decomposition["threads"]);
+        double const epochTime = decomposition["epochTime"];
+
+        // The grid is as square as the thread count allows
+        int cRows = static_cast<int>(sqrt(cThreads));
+        while(cThreads % cRows != 0)
+            cRows -= 1;
+        int const cColumns = cThreads / cRows;
+
+        PSE &emb = exec.emb;
+
+        // Regions are sets of points, so vertices of the input are placed first
+        bool const placed = all_of(emb.gamma.vertices.begin(), emb.gamma.vertices.end(), [](Vertex const &vertex) {
+            return vertex.isOccupying();
+        });
+        if(!placed) {
+            emb = Greedy::fastAssignment(emb);
+            emb.resetTracker();
+        }
+
+        PSE minEmb = emb;
+        long minScore = minEmb.lazyScore();
+        long cAccepted = 0;
+
+        // Workers only copy the dynamic data, the topology and point index are shared
+        vector<PSE> locals(cThreads, emb);
+        vector<long> cIters(cThreads, 0);
+        vector<long> cAccepts(cThreads, 0);
+
+        while(exec.inTime()) {
+            emb.fastCopy(minEmb);
+            vector<Region> const regions = partition(emb, cColumns, cRows);
+            long const end = exec.consumed<milliseconds>() + static_cast<long>(epochTime * 1000);
+
+            vector<uint64_t> const seeds = drawSeeds(cThreads);
+
+            TELEMETRY_SPAWNER;
+            vector<thread> workers;
+            for(int t=0; t<cThreads; t++) {
+                locals[t].fastCopy(emb);
+                workers.emplace_back([&, t]() {
+                    TELEMETRY_WORKER;
+                    seedThread(seeds[t]);
+                    anneal(exec, locals[t], regions[t], state, end, cIters[t], cAccepts[t]);
+                });
+            }
+            for(auto &worker : workers)
+                worker.join();
+
+            // Regions are disjoint, so their vertices only exchange points among each other
+            for(int t=0; t<cThreads; t++)
+                for(int const vertexId : regions[t].vertices)
+                    emb.moveToPoint(vertexId, locals[t].gamma.getVertex(vertexId).occupiedPoint);
+            emb.resetTracker();
+
+            for(int t=0; t<cThreads; t++) {
+                exec.cIter += cIters[t];
+                cAccepted += cAccepts[t];
+                cIters[t] = cAccepts[t] = 0;
+            }
+
+            long const score = emb.lazyScore();
+            if(score < minScore) {
+                minScore = score;
+                minEmb.fastCopy(emb);
+                exec.save(minScore, minEmb, 2);
+            }
+            exec.trace(score, minScore, nullopt, cAccepted);
+        }
+
+        return minEmb;
+    }
+
+protected:
+    /**
+     * Vertices and points of a region.
+     */
+    struct Region {
+        vector<int> vertices;
+        vector<int> points;
+    };
+
+    /**
+     * Partitions the points into columns of equally many points and each column into rows. All boundaries are shifted
+     * by a random part of a region, so vertices near a boundary are moved along with different neighbours over time.
+     * @param emb The PSE, whose vertices occupy points.
+     * @param cColumns Number of columns.
+     * @param cRows Number of rows per column.
+     */
+    static vector<Region> partition(PSE const &emb, int const cColumns, int const cRows) {
+        Xoshiro256 &gen = threadGenerator();
+        auto const cPoints = static_cast<long>(emb.points.size());
+
+        // Index of the first point of a part, where the shift is in [-0.5, 0.5)
+        auto const boundary = [](long const part, long const cParts, double const shift, long const size) {
+            if(part == 0 || part == cParts)
+                return part == 0 ? 0L : size;
+            double const share = (static_cast<double>(part) + shift) / static_cast<double>(cParts);
+            return clamp(static_cast<long>(llround(share * static_cast<double>(size))), 0L, size);
+        };
+        auto const drawShift = [&gen]() {
+            return static_cast<double>(gen.bounded(1024)) / 1024 - 0.5;
+        };
+
+        vector<int> byX(cPoints);
+        iota(byX.begin(), byX.end(), 0);
+        sort(byX.begin(), byX.end(), [&emb](int const a, int const b) {
+            return make_pair(emb.points[a].pos.x, a) < make_pair(emb.points[b].pos.x, b);
+        });
+
+        vector<Region> regions(static_cast<size_t>(cColumns) * cRows);
+        vector<int> regionOf(cPoints, 0);
+        double const columnShift = drawShift();
+        for(int c=0; c<cColumns; c++) {
+            vector<int> column(byX.begin() + boundary(c, cColumns, columnShift, cPoints),
+                               byX.begin() + boundary(c + 1, cColumns, columnShift, cPoints));
+            sort(column.begin(), column.end(), [&emb](int const a, int const b) {
+                return make_pair(emb.points[a].pos.y, a) < make_pair(emb.points[b].pos.y, b);
+            });
+
+            auto const cColumn = static_cast<long>(column.size());
+            double const rowShift = drawShift();
+            for(int r=0; r<cRows; r++) {
+                int const regionId = c * cRows + r;
+                for(long i=boundary(r, cRows, rowShift, cColumn); i<boundary(r + 1, cRows, rowShift, cColumn); i++) {
+                    regionOf[column[i]] = regionId;
+                    regions[regionId].points.push_back(column[i]);
+                }
+            }
+        }
+
+        for(Vertex const &vertex : emb.gamma.vertices)
+            regions[regionOf[vertex.occupiedPoint]].vertices.push_back(vertex.id);
+        return regions;
+    }
+
+    /**
+     * Anneals the vertices of a region by random walks to the region's points until the end of the epoch.
+     * @param exec The executor.
+     * @param emb Copy of the worker.
+     * @param region The region.
+     * @param state The runtime configuration.
+     * @param end Time in ms since the start of the executor.
+     * @param cIter Counter of the iterations.
+     * @param cAccepted Counter of the accepted proposals.
+     */
+    static void anneal(Executor const &exec, PSE &emb, Region const &region, AnnealingState const &state,
+                       long const end, long &cIter, long &cAccepted) {
+        if(region.vertices.empty())
+            return;
+
+        Xoshiro256 &gen = threadGenerator();
+        double temp = state.initTemp;
+        long currIter = 0;
+
+        while(exec.consumed<milliseconds>() < end && exec.inTime()) {
+            int const vertexId = region.vertices[gen.bounded(region.vertices.size())];
+            int const pointId = region.points[gen.bounded(region.points.size())];
+
+            if(emb.boundedMoveOrSwap(vertexId, pointId, acceptanceBound(temp, randPercent.pull()))) {
+                TELEMETRY_COUNT(accepted);
+                cAccepted += 1;
+            }
+            else {
+                TELEMETRY_COUNT(rejected);
+            }
+
+            currIter += 1;
+            temp = Cooling::cool(temp, currIter, state);
+        }
+
+        cIter += currIter;
+    }
+};
+
+#endif
@@ -80,6 +80,7 @@ public:
 
             temp *= cool;
             currIter += 1;
+            exec.trace(-1, -1, temp);
         }
         
         return normalize(emb);
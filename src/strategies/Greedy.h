@@ -11,10 +11,10 @@ public:
         importConfig("greedy.json");
 
         if(conf["useSlow"] && !conf["useFast"])
-            return slowAssignment(exec.emb);
+            return slowAssignment(exec.emb, &exec);
 
         if(conf["useFast"] && !conf["useSlow"])
-            return fastAssignment(exec.emb);
+            return fastAssignment(exec.emb, &exec);
 
         PSE aEmb = exec.emb;
         PSE bEmb = exec.emb;
@@ -23,8 +23,9 @@ public:
         thread fastThread([&resultFast, aEmb]() {
             resultFast = Greedy::fastAssignment(aEmb);
         });
-        thread slowThread([&resultSlow, bEmb]() {
-            resultSlow = Greedy::slowAssignment(bEmb);
+        // Only the slow assignment reports its progress, since the executor is not shared among threads
+        thread slowThread([&resultSlow, bEmb, &exec]() {
+            resultSlow = Greedy::slowAssignment(bEmb, &exec);
         });
 
         fastThread.join();
@@ -35,15 +36,15 @@ public:
         return resultSlow;
     }
 
-private:
-
     /**
      **************************
      * Fast Greedy Assignment *
      **************************
      * @coauthor Alexander Kutscheid
+     * @param emb The PSE.
+     * @param exec Executor tracing the number of assigned vertices, if given.
      */
-    static PSE fastAssignment(PSE emb) {
+    static PSE fastAssignment(PSE emb, Executor *const exec = nullptr) {
         Drawing &gamma = emb.gamma;
 
         for(Vertex const &vertex: gamma.vertices) {
@@ -63,6 +64,7 @@ private:
 
             // Moves the vertex to the closest point
             emb.moveToPoint(vertex.id, closest);
+            progress(exec);
         }
 
         return emb;
@@ -73,8 +75,10 @@ private:
      * Slow Greedy Assignment *
      **************************
      * @coauthor Alexander Kutscheid
+     * @param emb The PSE.
+     * @param exec Executor tracing the number of assigned vertices, if given.
      */
-    static PSE slowAssignment(PSE emb) {
+    static PSE slowAssignment(PSE emb, Executor *const exec = nullptr) {
         Drawing &gamma = emb.gamma;
 
         int cAssigned = 0;
@@ -101,11 +105,23 @@ private:
             if(assign.second != -1) {
                 emb.moveToPoint(assign.first, assign.second);
                 cAssigned++;
+                progress(exec);
             }
         }
 
         return emb;
     }
+
+private:
+    /**
+     * Counts an assigned vertex as iteration of the trace. The score is only known once all vertices are assigned.
+     */
+    static void progress(Executor *const exec) {
+        if(exec == nullptr)
+            return;
+        exec->cIter += 1;
+        exec->trace(-1, -1);
+    }
 };
 
 #endif
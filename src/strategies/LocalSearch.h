@@ -0,0 +1,115 @@
+#ifndef PROJECT_LOCAL_SEARCH_H
+#define PROJECT_LOCAL_SEARCH_H
+
+#include "../source/dependencies.h"
+
+using namespace std;
+using namespace chrono;
+
+
+class LocalSearch final : public Strategy {
+public:
+    explicit LocalSearch() : Strategy() { }
+
+    /**
+     ***************************
+     * Steepest Descent Search *
+     ***************************
+     * Visits the vertices from hottest to coldest and evaluates moving or swapping each to its k nearest points.
+     * The best improving candidate is applied. Terminates once a whole pass yields no improvement.
+     */
+    PSE run(Executor &exec) override {
+        importConfig("ls.json");
+        int const cNearest = conf["nearest"];
+        long const minParallelWork = conf["minParallelWork"];
+
+        // Threads persist across all evaluations of the search
+        WorkerPool pool(threadCount(conf["threads"]));
+
+        PSE &emb = exec.emb;
+        long score = emb.lazyScore();
+
+        long const start = exec.consumed<milliseconds>();
+        long cEvaluated = 0;
+        long cImproved = 0;
+
+        vector<int> order(emb.gamma.vertices.size());
+        bool improved = true;
+        while(improved && exec.inTime()) {
+            improved = false;
+
+            // Hottest vertices first
+            iota(order.begin(), order.end(), 0);
+            stable_sort(order.begin(), order.end(), [&emb](int const a, int const b) {
+                return emb.gamma.temps[a] > emb.gamma.temps[b];
+            });
+
+            for(int const vertexId : order) {
+                Vertex const &vertex = emb.gamma.getVertex(vertexId);
+
+                // Cold vertices cannot improve, neither can vertices that are not placed on points
+                if(emb.gamma.temps[vertex.id] == 0 || !exec.inTime())
+                    break;
+                if(!vertex.isOccupying())
+                    continue;
+
+                vector<int> const candidates = emb.nNearestPoints(vertex.occupiedPoint, cNearest);
+                bool const parallel = static_cast<long>(candidates.size() * emb.gamma.sources().size()) >= minParallelWork;
+                pair<long, int> const best = steepest(emb, vertex.id, candidates, parallel ? &pool : nullptr);
+                cEvaluated += static_cast<long>(candidates.size());
+                exec.cIter += 1;
+
+                if(best.first < 0) {
+                    emb.trackedMoveOrSwap(vertex.id, best.second);
+                    cImproved += 1;
+                    improved = true;
+                }
+                exec.trace(emb.lazyScore(), min(score, emb.lazyScore()), nullopt, cImproved);
+            }
+
+            if(improved && emb.lazyScore() < score) {
+                score = emb.lazyScore();
+                exec.save(score, emb, 2);
+            }
+        }
+
+        double const secs = max(1L, exec.consumed<milliseconds>() - start) / 1000.0;
+        {
+            lock_guard guard(console);
+            cout << endl << "Local search report of " << exec.name << endl;
+            cout << "moves/s = " << static_cast<double>(cEvaluated) / secs << endl;
+            cout << "improvements/s = " << static_cast<double>(cImproved) / secs << endl;
+        }
+
+        return emb;
+    }
+
+protected:
+    /**
+     * Evaluates all candidates on the unmodified PSE, concurrently by the pool if given.
+     * Relocations to free points are evaluated by a radial sweep around the candidates.
+     * @param emb The PSE.
+     * @param vertexId ID of the vertex to be relocated.
+     * @param candidates IDs of the target points.
+     * @param pool Workers sharing the candidates or nullptr to evaluate them on the calling thread.
+     * @return Best score change and the corresponding point.
+     */
+    [[nodiscard]] static pair<long, int> steepest(PSE const &emb, int const vertexId, vector<int> const &candidates,
+                                                  WorkerPool *const pool) {
+        int const cWorkers = pool != nullptr ? pool->size() : 1;
+        RadialSweep const sweep(emb, vertexId, cWorkers);
+        vector<pair<long, int>> bests(cWorkers);
+
+        auto const evaluate = [&](int const worker) {
+            bests[worker] = sweep.best(candidates, worker, cWorkers);
+        };
+
+        if(pool != nullptr)
+            pool->run(evaluate);
+        else evaluate(0);
+
+        return *min_element(bests.begin(), bests.end());
+    }
+};
+
+#endif
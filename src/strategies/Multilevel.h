@@ -0,0 +1,415 @@
+#ifndef PROJECT_MULTILEVEL_H
+#define PROJECT_MULTILEVEL_H
+
+#include "../source/dependencies.h"
+#include "Greedy.h"
+
+using namespace std;
+
+
+/**
+ * Uniform grid of points, from which the nearest free points are taken one by one.
+ */
+class FreePointGrid {
+public:
+    /**
+     * @param points The points, which are all free initially.
+     */
+    explicit FreePointGrid(vector<Point> const &points) : positions(points.size()), cellIds(points.size()) {
+        double minX = numeric_limits<double>::max(), minY = numeric_limits<double>::max();
+        double maxX = numeric_limits<double>::lowest(), maxY = numeric_limits<double>::lowest();
+        for(Point const &point : points) {
+            minX = min(minX, static_cast<double>(point.pos.x));
+            minY = min(minY, static_cast<double>(point.pos.y));
+            maxX = max(maxX, static_cast<double>(point.pos.x));
+            maxY = max(maxY, static_cast<double>(point.pos.y));
+        }
+
+        // About two points per cell
+        side = max(1, static_cast<int>(ceil(sqrt(static_cast<double>(points.size()) / 2))));
+        originX = minX;
+        originY = minY;
+        cellWidth = max(1.0, (maxX - minX) / side);
+        cellHeight = max(1.0, (maxY - minY) / side);
+
+        cells.resize(static_cast<size_t>(side) * side);
+
+        // The cells are remembered, since fast math may round the recomputed cell of a point differently
+        for(Point const &point : points) {
+            positions[point.id] = point.pos;
+            cellIds[point.id] = cellOf(point.pos);
+            cells[cellIds[point.id]].push_back(point.id);
+        }
+    }
+
+    /**
+     * Takes a point, which must be free.
+     * @param pointId ID of the point.
+     */
+    void take(int const pointId) {
+        vector<int> &cell = cells[cellIds[pointId]];
+        auto it = find(cell.begin(), cell.end(), pointId);
+        *it = cell.back();
+        cell.pop_back();
+    }
+
+    /**
+     * Takes the free point closest to a position, where ties are broken by the lower ID.
+     * @param pos The position.
+     * @return ID of the point or -1 if all points are taken.
+     */
+    int takeNearest(Position const &pos) {
+        int const cx = clamp(static_cast<int>((static_cast<double>(pos.x) - originX) / cellWidth), 0, side - 1);
+        int const cy = clamp(static_cast<int>((static_cast<double>(pos.y) - originY) / cellHeight), 0, side - 1);
+
+        pair<double, int> best = {numeric_limits<double>::max(), -1};
+        for(int r=0; r<side; r++) {
+            // Points of further rings are at least this far away
+            if(best.second != -1 && best.first <= (r - 1) * min(cellWidth, cellHeight))
+                break;
+
+            // Visit the cells of the ring only, i.e., inner columns just at their top and bottom
+            for(int x=max(0, cx - r); x<=min(side - 1, cx + r); x++) {
+                int const step = abs(x - cx) == r ? 1 : max(1, 2 * r);
+                for(int y=cy - r; y<=cy + r; y+=step)
+                    if(y >= 0 && y < side)
+                        for(int const pointId : cells[static_cast<size_t>(x) * side + y])
+                            best = min(best, {VectorSpace::dist(pos, positions[pointId]), pointId});
+            }
+        }
+
+        if(best.second != -1)
+            take(best.second);
+        return best.second;
+    }
+
+private:
+    int side = 1;
+    double originX = 0, originY = 0;
+    double cellWidth = 1, cellHeight = 1;
+
+    vector<Position> positions;
+    vector<size_t> cellIds;
+    vector<vector<int>> cells;
+
+    [[nodiscard]] size_t cellOf(Position const &pos) const {
+        int const x = clamp(static_cast<int>((static_cast<double>(pos.x) - originX) / cellWidth), 0, side - 1);
+        int const y = clamp(static_cast<int>((static_cast<double>(pos.y) - originY) / cellHeight), 0, side - 1);
+        return static_cast<size_t>(x) * side + y;
+    }
+};
+
+
+class Multilevel final : public Strategy {
+public:
+    explicit Multilevel() : Strategy() { }
+
+    /**
+     ***********************************
+     * Multilevel Coarsen-Place-Refine *
+     ***********************************
+     * The graph is coarsened by heavy edge matchings. Each level is embedded on a random sample of the points, where
+     * the samples are nested and keep the ratio of points to vertices. The coarsest level is placed greedily, then each
+     * level is projected onto the next finer one and refined by tracked moves.
+     * @reference: https://doi.org/10.1007/3-540-44541-2_17
+     */
+    PSE run(Executor &exec) override {
+        importConfig("ml.json");
+        PSE const &emb = exec.emb;
+
+        // Each level may use an equal share of the remaining time, which coarse levels rarely exhaust
+        double const maxShare = conf["maxShare"];
+        long const deadline = exec.consumed<milliseconds>() + static_cast<long>(exec.maxTime * 60000 * maxShare);
+        auto const slice = [&](long const cLevels) {
+            long const now = exec.consumed<milliseconds>();
+            return now + max(0L, deadline - now) / cLevels;
+        };
+
+        vector<Level> levels = coarsen(emb.gamma);
+        if(levels.size() == 1) {
+            // The graph is too small to be coarsened
+            PSE result = Greedy::fastAssignment(emb);
+            refine(exec, result, deadline);
+            return result;
+        }
+
+        // Level i > 0 uses the first points of this order, so each sample contains the coarser ones
+        vector<int> order(emb.points.size());
+        iota(order.begin(), order.end(), 0);
+        shuffle(order.begin(), order.end(), threadGenerator());
+
+        // Place the coarsest level greedily
+        PSE coarse = Greedy::fastAssignment(levelEmbedding(emb, levels.back(), order));
+        refine(exec, coarse, slice(static_cast<long>(levels.size())));
+
+        for(long i=static_cast<long>(levels.size())-2; i>=0; i--) {
+            vector<int> const assignment = i == 0
+                    ? project(coarse, levels[i], emb.points, order, true)
+                    : project(coarse, levels[i], samplePoints(emb, levels[i], order), order, false);
+
+            // The finest level is the original PSE, whose vertices may already occupy points
+            if(i == 0) {
+                PSE result = emb;
+                for(int vertexId=0; vertexId<static_cast<int>(assignment.size()); vertexId++)
+                    result.moveToPoint(vertexId, assignment[vertexId]);
+                result.resetTracker();
+                refine(exec, result, deadline);
+                return result;
+            }
+
+            PSE finer = levelEmbedding(emb, levels[i], order);
+            for(int vertexId=0; vertexId<static_cast<int>(assignment.size()); vertexId++)
+                finer.moveToPoint(vertexId, assignment[vertexId]);
+            refine(exec, finer, slice(i + 1));
+            coarse = std::move(finer);
+        }
+
+        return coarse;
+    }
+
+protected:
+    /**
+     * Graph of a coarsening level.
+     */
+    struct Level {
+        // Number of original vertices per vertex
+        vector<int> weights;
+
+        // Mean position of the original vertices per vertex
+        vector<Position> positions;
+
+        // Neighbours with the number of merged edges, without loops
+        vector<vector<pair<int, int>>> adjacency;
+
+        // Vertex of the next coarser level per vertex
+        vector<int> parents;
+
+        [[nodiscard]] int cVertices() const {
+            return static_cast<int>(weights.size());
+        }
+    };
+
+    /**
+     * Coarsens a graph until the coarsest level is small or the matchings stagnate.
+     * @param gamma Drawing of the original graph.
+     * @return The levels, beginning with the original graph.
+     */
+    vector<Level> coarsen(Drawing const &gamma) {
+        int const coarsestSize = conf["coarsestSize"];
+        double const minShrink = conf["minShrink"];
+
+        vector<Level> levels(1);
+        Level &original = levels.front();
+        for(Vertex const &vertex : gamma.vertices) {
+            original.weights.push_back(1);
+            original.positions.push_back(vertex.pos);
+
+            auto &adjacent = original.adjacency.emplace_back();
+            for(int const neighbourId : gamma.getNeighbours(vertex.id))
+                adjacent.emplace_back(neighbourId, 1);
+        }
+
+        while(levels.back().cVertices() > coarsestSize) {
+            Level next = match(levels.back());
+            if(next.cVertices() > minShrink * levels.back().cVertices()) {
+                levels.back().parents.clear();
+                break;
+            }
+            levels.push_back(std::move(next));
+        }
+
+        return levels;
+    }
+
+    /**
+     * Merges a heavy edge matching of a level. Visited in random order, each vertex is matched with the unmatched
+     * neighbour of the most merged edges relative to the weights, which keeps the clusters balanced.
+     * @param level The finer level, whose parents are set.
+     * @return The coarser level.
+     */
+    static Level match(Level &level) {
+        int const cVertices = level.cVertices();
+        vector<int> order(cVertices);
+        iota(order.begin(), order.end(), 0);
+        shuffle(order.begin(), order.end(), threadGenerator());
+
+        Level coarse;
+        level.parents.assign(cVertices, -1);
+        for(int const vertexId : order) {
+            if(level.parents[vertexId] != -1)
+                continue;
+
+            int mate = -1;
+            double maxRating = 0;
+            for(auto const &[neighbourId, cMerged] : level.adjacency[vertexId]) {
+                double const rating = cMerged / static_cast<double>(level.weights[vertexId] * level.weights[neighbourId]);
+                if(level.parents[neighbourId] == -1 && rating > maxRating) {
+                    maxRating = rating;
+                    mate = neighbourId;
+                }
+            }
+
+            int const parentId = coarse.cVertices();
+            int weight = level.weights[vertexId];
+            Position pos = level.positions[vertexId];
+            level.parents[vertexId] = parentId;
+
+            if(mate != -1) {
+                int const mateWeight = level.weights[mate];
+                pos = {(pos.x * weight + level.positions[mate].x * mateWeight) / (weight + mateWeight),
+                       (pos.y * weight + level.positions[mate].y * mateWeight) / (weight + mateWeight)};
+                weight += mateWeight;
+                level.parents[mate] = parentId;
+            }
+
+            coarse.weights.push_back(weight);
+            coarse.positions.push_back(pos);
+        }
+
+        // Merge parallel edges and drop the matched ones
+        coarse.adjacency.resize(coarse.cVertices());
+        vector<int> slot(coarse.cVertices(), -1);
+        vector<vector<int>> members(coarse.cVertices());
+        for(int vertexId=0; vertexId<cVertices; vertexId++)
+            members[level.parents[vertexId]].push_back(vertexId);
+
+        for(int parentId=0; parentId<coarse.cVertices(); parentId++) {
+            auto &adjacent = coarse.adjacency[parentId];
+            for(int const memberId : members[parentId])
+                for(auto const &[neighbourId, cMerged] : level.adjacency[memberId]) {
+                    int const otherId = level.parents[neighbourId];
+                    if(otherId == parentId)
+                        continue;
+                    if(slot[otherId] == -1) {
+                        slot[otherId] = static_cast<int>(adjacent.size());
+                        adjacent.emplace_back(otherId, 0);
+                    }
+                    adjacent[slot[otherId]].second += cMerged;
+                }
+
+            for(auto const &[otherId, cMerged] : adjacent)
+                slot[otherId] = -1;
+        }
+
+        return coarse;
+    }
+
+    /**
+     * Samples the points of a coarse level, renumbered by the order.
+     */
+    static vector<Point> samplePoints(PSE const &emb, Level const &level, vector<int> const &order) {
+        // Keep the ratio of points to vertices of the instance
+        double const ratio = static_cast<double>(emb.points.size()) / static_cast<double>(emb.gamma.vertices.size());
+        auto const cPoints = static_cast<int>(min(order.size(), static_cast<size_t>(ceil(level.cVertices() * ratio))));
+
+        vector<Point> points;
+        for(int i=0; i<cPoints; i++) {
+            Point const &point = emb.points[order[i]];
+            points.emplace_back(i, static_cast<int>(point.pos.x), static_cast<int>(point.pos.y));
+        }
+        return points;
+    }
+
+    /**
+     * Creates the unplaced PSE of a coarse level.
+     */
+    static PSE levelEmbedding(PSE const &emb, Level const &level, vector<int> const &order) {
+        vector<Vertex> vertices;
+        for(int vertexId=0; vertexId<level.cVertices(); vertexId++)
+            vertices.emplace_back(vertexId, level.positions[vertexId].x, level.positions[vertexId].y);
+
+        vector<Edge> edges;
+        for(int vertexId=0; vertexId<level.cVertices(); vertexId++)
+            for(auto const &[neighbourId, cMerged] : level.adjacency[vertexId])
+                if(vertexId < neighbourId)
+                    edges.emplace_back(static_cast<int>(edges.size()), vertices[vertexId], vertices[neighbourId]);
+
+        vector<Point> points = samplePoints(emb, level, order);
+        return {Drawing(vertices, edges), points, emb.width, emb.height};
+    }
+
+    /**
+     * Projects the placement of a coarse level onto a finer one. The first vertex of each cluster takes the point of
+     * the cluster, which is also part of the finer sample, and the others take the nearest free points afterwards.
+     * @param coarse The placed coarse level.
+     * @param level The finer level.
+     * @param points Points of the finer level.
+     * @param order Order of the samples, whose positions are the IDs of the sampled points.
+     * @param isOriginal Is the finer level the original PSE?
+     * @return The point per vertex of the finer level.
+     */
+    static vector<int> project(PSE const &coarse, Level const &level, vector<Point> const &points,
+                               vector<int> const &order, bool const isOriginal) {
+        FreePointGrid grid(points);
+        vector<int> assignment(level.cVertices(), -1);
+        vector<bool> isClaimed(coarse.gamma.vertices.size(), false);
+
+        // Claim the points of the clusters first, so they are not taken as nearest free points
+        for(int vertexId=0; vertexId<level.cVertices(); vertexId++) {
+            int const parentId = level.parents[vertexId];
+            if(!isClaimed[parentId]) {
+                int const pointId = coarse.gamma.vertices[parentId].occupiedPoint;
+                isClaimed[parentId] = true;
+                assignment[vertexId] = isOriginal ? order[pointId] : pointId;
+                grid.take(assignment[vertexId]);
+            }
+        }
+
+        for(int vertexId=0; vertexId<level.cVertices(); vertexId++)
+            if(assignment[vertexId] == -1) {
+                int const pointId = coarse.gamma.vertices[level.parents[vertexId]].occupiedPoint;
+                assignment[vertexId] = grid.takeNearest(coarse.points[pointId].pos);
+            }
+
+        return assignment;
+    }
+
+    /**
+     * Refines a level by tracked moves that do not worsen the score. Vertices move towards the nearest points of a
+     * neighbour or occasionally to a random point. The refinement stops once a round of |V| moves gains too little.
+     * @param exec The executor.
+     * @param emb The placed PSE of the level.
+     * @param deadline Time in ms since the start of the executor, when the refinement stops anyway.
+     */
+    void refine(Executor &exec, PSE &emb, long const deadline) {
+        long const maxRounds = conf["maxRounds"];
+        double const minGain = conf["minGain"];
+        int const cCandidates = static_cast<int>(min(static_cast<long>(conf["candidates"]), emb.gamma.maxDeg));
+        double const chooseFar = conf["chooseFar"];
+
+        vector<int> &nearest = ScratchArena::take(ScratchArena::nearest);
+        Xoshiro256 &gen = threadGenerator();
+        auto const cVertices = static_cast<long>(emb.gamma.vertices.size());
+
+        for(long round=0; round<maxRounds; round++) {
+            long const before = emb.lazyScore();
+            for(long i=0; i<cVertices; i++) {
+                if(exec.consumed<milliseconds>() >= deadline || !exec.inTime())
+                    return;
+
+                Vertex const &vertex = emb.gamma.getRandomVertex(0);
+                vector<int> const &neighbours = emb.gamma.getNeighbours(vertex.id);
+
+                int target;
+                if(neighbours.empty() || cCandidates < 1 || randPercent.pull() < chooseFar * 100)
+                    target = emb.getRandomPoint().id;
+                else {
+                    int const neighbourId = neighbours[gen.bounded(neighbours.size())];
+                    emb.nNearestPoints(emb.gamma.getVertex(neighbourId).occupiedPoint, cCandidates, nearest);
+                    target = nearest[gen.bounded(nearest.size())];
+                }
+
+                emb.boundedMoveOrSwap(vertex.id, target, 0);
+                exec.cIter += 1;
+            }
+
+            // Scores of coarse levels refer to their own, smaller graphs
+            exec.trace(emb.lazyScore(), -1);
+
+            if(static_cast<double>(before - emb.lazyScore()) < minGain * static_cast<double>(before))
+                return;
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef PROJECT_REGISTRY_H
+#define PROJECT_REGISTRY_H
+
+#include "../source/dependencies.h"
+
+// A new strategy is included here and registered by its name in createStrategy
+#include "Bruteforce.h"
+#include "BranchAndBound.h"
+#include "ForceDirected.h"
+#include "Greedy.h"
+#include "LocalSearch.h"
+#include "Multilevel.h"
+#include "SimulatedAnnealing.h"
+#include "DecomposedAnnealing.h"
+#include "Analysis.h"
+
+using namespace std;
+
+
+/**
+ * Creates a strategy by its name on the command line.
+ * @param name Name of the strategy, e.g., sa[walk].
+ * @throws runtime_error if the strategy is unknown.
+ */
+inline unique_ptr<Strategy> createStrategy(string const &name) {
+    static unordered_map<string, function<unique_ptr<Strategy>()>> const algos = {
+        {"bruteforce", []() { return make_unique<Bruteforce>(); }},
+        {"bnb", []() { return make_unique<BranchAndBound>(); }},
+        {"fda[fr]", []() { return make_unique<ForceDirected>(repelFR, attractFR, coolFR); }},
+        {"fda[spring]", []() { return make_unique<ForceDirected>(repelSpring, attractSpring, coolSpring); }},
+        {"greedy", []() { return make_unique<Greedy>(); }},
+        {"analysis", []() { return make_unique<Analysis>(); }},
+        {"ls[steepest]", []() { return make_unique<LocalSearch>(); }},
+        {"multilevel", []() { return make_unique<Multilevel>(); }},
+        {"sa[walk]", []() { return make_unique<SimulatedAnnealing<RandomWalk, CoolExponential>>(); }},
+        {"sa[rebuild]", []() { return make_unique<SimulatedAnnealing<RebuildNeighbourhood, CoolExponential>>(); }},
+        {"sa[hybrid]", []() { return make_unique<SimulatedAnnealing<Hybrid, CoolExponential>>(); }},
+        {"sa[candidates]", []() { return make_unique<SimulatedAnnealing<CandidateWalk, CoolExponential>>(); }},
+        {"sa[walk,lin]", []() { return make_unique<SimulatedAnnealing<RandomWalk, CoolLinear>>(); }},
+        {"sa[rebuild,lin]", []() { return make_unique<SimulatedAnnealing<RebuildNeighbourhood, CoolLinear>>(); }},
+        {"sa[hybrid,lin]", []() { return make_unique<SimulatedAnnealing<Hybrid, CoolLinear>>(); }},
+        {"sa[decomp]", []() { return make_unique<DecomposedAnnealing<CoolExponential>>(); }},
+        {"sa[decomp,lin]", []() { return make_unique<DecomposedAnnealing<CoolLinear>>(); }},
+    };
+
+    auto it = algos.find(name);
+    if (it == algos.end())
+        throw runtime_error("Unimplemented strategy recognized.");
+    return it->second();
+}
+
+/**
+ * Runs a sequence of strategies, e.g., greedy+sa[walk], on the executor's PSE.
+ * @param exec The executor.
+ * @param seq The +-separated sequence.
+ * @throws runtime_error if a strategy is unknown.
+ */
+inline void runSequence(Executor &exec, string seq) {
+    transform(seq.begin(), seq.end(), seq.begin(), ::tolower);
+    for (string const &strategy : split(seq, '+')) {
+        unique_ptr<Strategy> algo = createStrategy(strategy);
+        exec.run(*algo);
+    }
+}
+
+#endif
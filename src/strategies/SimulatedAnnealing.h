@@ -3,27 +3,146 @@
 
 #include <utility>
 #include "dependencies.h"
+#include "Greedy.h"
 
-class SimulatedAnnealing final : public Strategy {
+
+/**
+ * Candidate points per vertex, stored as compressed sparse rows: the points nearest to the centroid of the
+ * vertex's neighbours, followed by the points nearest to the vertex itself.
+ */
+class CandidateLists {
 public:
-    explicit SimulatedAnnealing(
-        const function<PSE(PSE& emb, vector<double> &runConf)>& refactor,
-        const function<double(double temp, long cIter, PSE& emb, vector<double> &runConf)>& cooling
-    ) : funcRefactor(refactor), funcCooling(cooling) {};
+    /**
+     * Rebuilds the lists for the current placement, whose vertices must occupy points.
+     * @param emb The PSE.
+     * @param cCentroid Number of points near the centroid of the neighbours.
+     * @param cNearest Number of points near the vertex.
+     */
+    void build(PSE &emb, int const cCentroid, int const cNearest) {
+        vector<int> &centroidPoints = ScratchArena::take(ScratchArena::nearest);
+        vector<int> &nearest = ScratchArena::take(ScratchArena::candidates);
+
+        offsets.assign(1, 0);
+        points.clear();
+        for(Vertex const &vertex : emb.gamma.vertices) {
+            vector<int> const &neighbours = emb.gamma.getNeighbours(vertex.id);
+            centroidPoints.clear();
+            if(!neighbours.empty()) {
+                double x = 0, y = 0;
+                for(int const neighbourId : neighbours) {
+                    x += static_cast<double>(emb.gamma.getVertex(neighbourId).pos.x);
+                    y += static_cast<double>(emb.gamma.getVertex(neighbourId).pos.y);
+                }
+                auto const cNeighbours = static_cast<double>(neighbours.size());
+                emb.nearestPoints({x / cNeighbours, y / cNeighbours}, cCentroid, centroidPoints);
+            }
+            emb.nNearestPoints(vertex.occupiedPoint, cNearest, nearest);
+
+            // Both lists are short, so duplicates are found by linear search
+            auto const first = static_cast<long>(points.size());
+            for(vector<int> const *list : {&centroidPoints, &nearest})
+                for(int const pointId : *list)
+                    if(find(points.begin() + first, points.end(), pointId) == points.end())
+                        points.push_back(pointId);
+            offsets.push_back(static_cast<int>(points.size()));
+        }
+    }
+
+    [[nodiscard]] bool isEmpty() const {
+        return points.empty();
+    }
 
-    vector<double> runConf;
-    enum Param {
-        initTemp = 0,
-        distribExp = 1,
+    /**
+     * Draws a uniform candidate of a vertex.
+     * @param vertexId ID of the vertex.
+     * @return ID of the point or -1 if the vertex has no candidates.
+     */
+    [[nodiscard]] int draw(int const vertexId) const {
+        int const cCandidates = offsets[vertexId + 1] - offsets[vertexId];
+        if(cCandidates == 0)
+            return -1;
+        return points[offsets[vertexId] + static_cast<int>(threadGenerator().bounded(cCandidates))];
+    }
 
-        expBase = 2,
-        linFact = 3,
-        chooseFar = 4,
+private:
+    vector<int> offsets;
+    vector<int> points;
+};
 
-        loopTime = 5,
-        nextMethod = 6,
-        lastImp = 7
-    };
+
+/**
+ * Runtime configuration and state of an annealing, shared with the move and cooling policies.
+ */
+struct AnnealingState {
+    // Configuration from SA.json
+    double initTemp = 1;
+    int distribExp = 1;
+    double expBase = 0.94;
+    double linFact = 0.85;
+    double chooseFar = 0;
+    double loopTime = 5;
+    int cCentroid = 8;
+    int cNearest = 8;
+    double jumpFar = 0.05;
+    long refreshLoops = 1;
+
+    // Candidate points of the candidate walk and outer loops since their last refresh
+    CandidateLists candidates;
+    long sinceRefresh = 0;
+
+    // Has the hybrid switched to the random walk?
+    bool walking = false;
+
+    // Outer loops since the last improvement
+    long lastImp = 0;
+
+    // Maximal accepted score change of the current proposal
+    long maxDelta = 0;
+
+    // Was the current proposal rejected early?
+    bool rejected = false;
+
+    // Moves of the current proposal, only collected while recording
+    bool recording = false;
+    vector<pair<int, int>> proposal;
+
+    /**
+     * Collects a move of the current proposal for the recorder.
+     */
+    void propose(int const vertexId, int const pointId) {
+        if(recording)
+            proposal.emplace_back(vertexId, pointId);
+    }
+};
+
+
+/**
+ * Converts a drawn percentage into the maximal score change accepted by the Metropolis criterion.
+ * A change is accepted if exp(-delta / temp) * 100 is at least the percentage.
+ * @param temp Current temperature.
+ * @param percent Random value in [0, 99].
+ */
+inline long acceptanceBound(double const temp, long const percent) {
+    if(percent <= 0)
+        return PSE::UNBOUNDED;
+    if(temp <= 0)
+        return 0;
+
+    double const bound = floor(temp * log(100.0 / static_cast<double>(percent)));
+    return static_cast<long>(min(bound, static_cast<double>(PSE::UNBOUNDED)));
+}
+
+
+/**
+ * The move policy provides `static void refactor(PSE&, AnnealingState&)` and `static void prepare(PSE&,
+ * AnnealingState&)`, which is called before each outer loop, the cooling policy
+ * `static double cool(double temp, long cIter, AnnealingState const&)`. Both are resolved at compile time, so the
+ * calls are inlined into the annealing loop.
+ */
+template<typename Move, typename Cooling>
+class SimulatedAnnealing final : public Strategy {
+public:
+    explicit SimulatedAnnealing() : Strategy() { }
 
     /**
      ***********************
@@ -37,21 +156,52 @@ public:
         importConfig("SA.json");
 
         // Prepare the runtime configuration
-        runConf.resize(8);
-        runConf[Param::initTemp] = conf["initTemp"];
-        runConf[Param::distribExp] = conf["distribExp"];
-        runConf[Param::expBase] = conf["exponential"]["base"];
-        runConf[Param::linFact] = conf["linear"]["factor"];
-        runConf[Param::chooseFar] = conf["rebuild-neighbours"]["chooseFar"];
-        runConf[Param::loopTime] = conf["loopTime"];
-        runConf[Param::nextMethod] = 0.0;
-        runConf[Param::lastImp] = 0.0;
+        AnnealingState state;
+        state.initTemp = conf["initTemp"];
+        state.distribExp = conf["distribExp"];
+        state.expBase = conf["exponential"]["base"];
+        state.linFact = conf["linear"]["factor"];
+        state.chooseFar = conf["rebuild-neighbours"]["chooseFar"];
+        state.loopTime = conf["loopTime"];
+        state.cCentroid = conf["candidate-walk"]["centroid"];
+        state.cNearest = conf["candidate-walk"]["nearest"];
+        state.jumpFar = conf["candidate-walk"]["jumpFar"];
+        state.refreshLoops = conf["candidate-walk"]["refreshLoops"];
 
         PSE &emb = exec.emb;
+
+        // The moves and candidate lists start from occupied points, so vertices of the input are placed first
+        bool const placed = all_of(emb.gamma.vertices.begin(), emb.gamma.vertices.end(), [](Vertex const &vertex) {
+            return vertex.isOccupying();
+        });
+        if(!placed) {
+            emb = Greedy::fastAssignment(emb);
+            emb.resetTracker();
+        }
+
+        // Very large instances are first annealed on sampled scores, which are independent of the instance size
+        if(emb.gamma.sources().size() >= conf["coarse"]["minEdges"])
+            coarsen(exec, emb, state);
+
         PSE minEmb = emb;
         PSE copy = emb;
 
         long minScore = minEmb.lazyScore();
+        long cAccepted = 0;
+
+        // Temporaries of the refactorings are drawn from scratch buffers of sufficient capacity
+        size_t const maxDeg = static_cast<size_t>(emb.gamma.maxDeg);
+        ScratchArena::reserve(ScratchArena::adjacent, 2 * maxDeg);
+        ScratchArena::reserve(ScratchArena::neighbours, maxDeg + 1);
+        ScratchArena::reserve(ScratchArena::nearest, maxDeg + 1);
+
+        // The proposals are recorded from the initial assignment on
+        MoveRecorder *const recorder = exec.recorder();
+        if(recorder != nullptr) {
+            state.recording = true;
+            state.proposal.reserve(maxDeg + 1);
+            recorder->start(emb);
+        }
 
         // int lastExport = 0;
         while(exec.inTime()) {
@@ -65,47 +215,147 @@ public:
             */
 
             long currIter = 0;
-            double temp = runConf[Param::initTemp];
+            double temp = state.initTemp;
             emb.fastCopy(minEmb);
+            if(recorder != nullptr)
+                recorder->restore();
+            Move::prepare(emb, state);
+
+            // Does the copy deviate from the current embedding?
+            bool diverged = true;
+
+            // Iterations must not allocate apart from saving results, which the allocations check verifies
+            AllocationProbe probe;
 
             long const start = exec.consumed<seconds>();
-            while((exec.consumed<seconds>() - start) < runConf[loopTime] && exec.inTime()) {
-                copy.fastCopy(emb);
-                funcRefactor(copy, runConf);
+            while((exec.consumed<seconds>() - start) < state.loopTime && exec.inTime()) {
+                if(diverged)
+                    copy.fastCopy(emb);
+
+                // The Metropolis criterion is drawn in advance, so refactorings can reject early
+                long const bound = acceptanceBound(temp, randPercent.pull());
+                state.maxDelta = bound;
+                state.rejected = false;
+                state.proposal.clear();
+                Move::refactor(copy, state);
 
                 long const newScore = copy.lazyScore();
                 long const oldScore = emb.lazyScore();
-                double const prob = exp((oldScore - newScore) / temp) * 100;
+                bool accepted = false;
 
-                if(newScore < oldScore) {
+                if(state.rejected) {
+                    TELEMETRY_COUNT(rejected);
+                    diverged = false;
+                }
+                else if(newScore - oldScore <= bound) {
+                    TELEMETRY_COUNT(accepted);
+                    accepted = true;
+                    cAccepted += 1;
                     emb.fastCopy(copy);
+                    diverged = false;
 
                     if(newScore < minScore) {
                         minScore = newScore;
                         minEmb.fastCopy(copy);
 
-                        runConf[Param::lastImp] = 0;
-                        exec.save(minScore, minEmb, 2);
+                        state.lastImp = 0;
+                        probe.exempt([&]() { exec.save(minScore, minEmb, 2); });
                     }
                 }
-                else if(randPercent.pull() <= prob)
-                    emb.fastCopy(copy);
+                else {
+                    TELEMETRY_COUNT(rejected);
+                    diverged = true;
+                }
+
+                if(recorder != nullptr)
+                    recorder->proposal(state.proposal, accepted);
 
                 currIter += 1;
                 exec.cIter += 1;
 
-                temp = funcCooling(temp, currIter, copy, runConf);
+                temp = Cooling::cool(temp, currIter, state);
+                probe.exempt([&]() { exec.trace(emb.lazyScore(), minScore, temp, cAccepted); });
             }
 
-            runConf[Param::lastImp] += 1;
+            state.lastImp += 1;
         }
 
+        if(recorder != nullptr)
+            recorder->end(emb.lazyScore());
         return minEmb;
     }
 
 protected:
-    function<PSE(PSE& emb, vector<double> &runConf)> funcRefactor;
-    function<double(double temp, long cIter, PSE& emb, vector<double> &runConf)> funcCooling;
+    /**
+     * Coarse phase on sampled scores. Random walk proposals are accepted by the difference of their estimated
+     * penalties, which are sampled from the same partner edges before and after a proposal. The temperature cools
+     * across all windows, so the phase is a single annealing run. It ends once the estimated total score changes less
+     * than the error budget or its confidence interval within a window, or once it used up its share of the time.
+     * Afterwards, the exact tracker is prepared from scratch.
+     * @param exec The executor.
+     * @param emb The PSE, whose vertices occupy points.
+     * @param state The runtime configuration.
+     */
+    void coarsen(Executor &exec, PSE &emb, AnnealingState const &state) {
+        json const &coarse = conf["coarse"];
+        long const cSamples = coarse["samples"];
+        long const cScoreSamples = coarse["scoreSamples"];
+        long const window = coarse["window"];
+        double const errorBudget = coarse["errorBudget"];
+        double const maxShare = coarse["maxShare"];
+
+        long const deadline = exec.consumed<milliseconds>() + static_cast<long>(exec.maxTime * 60000 * maxShare);
+        vector<int> &partners = ScratchArena::take(ScratchArena::partners);
+        partners.reserve(cSamples);
+
+        Estimate previous = emb.estimateScore(cScoreSamples);
+        double temp = state.initTemp;
+        long cIter = 0;
+
+        while(exec.inTime() && exec.consumed<milliseconds>() < deadline) {
+            int const vertexId = emb.gamma.getRandomVertex(0).id;
+            int const pointId = emb.getRandomPoint().id;
+            int const oldPointId = emb.gamma.getVertex(vertexId).occupiedPoint;
+            int const partnerId = emb.getPoint(pointId).occupierId;
+
+            // Penalties of all moved vertices against the same partners, where an edge between them counts once
+            emb.drawPartners(cSamples, partners);
+            auto const sampled = [&]() {
+                double pen = emb.samplePen(vertexId, partners).value;
+                if(partnerId != -1 && partnerId != vertexId)
+                    pen += emb.samplePen(partnerId, partners, vertexId).value;
+                return pen;
+            };
+
+            double const before = sampled();
+            emb.moveOrSwap(vertexId, pointId);
+            double const delta = sampled() - before;
+
+            // Moving the vertex back also reverts a swap
+            if(delta > static_cast<double>(acceptanceBound(temp, randPercent.pull())))
+                emb.moveOrSwap(vertexId, oldPointId);
+
+            cIter += 1;
+            exec.cIter += 1;
+            temp = Cooling::cool(temp, cIter, state);
+
+            if(cIter % window == 0) {
+                Estimate const current = emb.estimateScore(cScoreSamples);
+                exec.trace(llround(current.value), -1, temp);
+
+                double const change = abs(current.value - previous.value);
+                previous = current;
+                if(change <= max(errorBudget * current.value, current.halfWidth))
+                    break;
+            }
+        }
+
+        emb.resetTracker();
+
+        lock_guard guard(console);
+        cout << "Coarse phase of " << exec.name << ": " << cIter << " iterations, estimated score "
+             << llround(previous.value) << " +- " << llround(previous.halfWidth) << endl;
+    }
 };
 
 
@@ -116,18 +366,17 @@ protected:
  * @reference https://www.fys.ku.dk/~andresen/BAhome/ownpapers/perm-annealSched.pdf
  */
 
-inline auto coolExponential =
-    [](double temp, long cIter, PSE& emb, vector<double> &runConf) {
-        double const base = runConf[SimulatedAnnealing::Param::expBase];
-        return temp * base;
-    };
+struct CoolExponential {
+    static double cool(double const temp, long const, AnnealingState const &state) {
+        return temp * state.expBase;
+    }
+};
 
 // NOT CONSIDERED IN THE THESIS
-inline auto coolLinear =
-    [](double temp, long cIter, PSE& emb, vector<double> &runConf) {
-        double const initTemp = runConf[SimulatedAnnealing::Param::initTemp];
-        double const fact = runConf[SimulatedAnnealing::Param::linFact];
-        return initTemp - fact * cIter;
+struct CoolLinear {
+    static double cool(double const, long const cIter, AnnealingState const &state) {
+        return state.initTemp - state.linFact * static_cast<double>(cIter);
+    }
 };
 
 
@@ -137,57 +386,91 @@ inline auto coolLinear =
  **************************
  */
 
-inline auto randomWalk =
-        [](PSE& emb, vector<double> &runConf){
-            Vertex vertex;
-            int exp = static_cast<int>(runConf[SimulatedAnnealing::Param::distribExp]);
-            vertex = emb.gamma.getRandomVertex(exp);
-
-            Point const &point = emb.getRandomPoint();
-            emb.trackedMoveOrSwap(vertex.id, point.id);
-            return emb;
-        };
-
-inline auto rebuildNeighbourhood =
-        [](PSE& emb, vector<double> &runConf){
-            Vertex vertex;
-            int exp = static_cast<int>(runConf[SimulatedAnnealing::Param::distribExp]);
-            vertex = emb.gamma.getRandomVertex(exp);
-
-            // Get the nearest points
-            vector<int> neighbours = emb.gamma.getNeighbours(vertex.id);
-            vector<int> nearest = emb.nNearestPoints(vertex.occupiedPoint, vertex.deg);
-
-            neighbours.push_back(vertex.id);
-            nearest.push_back(vertex.occupiedPoint);
-
-            // Shuffle the nearest points
-            shuffle(nearest.begin(), nearest.end(), default_random_engine(randPercent.pull()));
-
-            // Allow points in a far distance
-            double probFar = runConf[SimulatedAnnealing::Param::chooseFar];
-            for(int i=0; i<neighbours.size(); i++) {
-                if(randPercent.pull() < (probFar * 100))
-                    emb.trackedMoveOrSwap(neighbours[i], emb.getRandomPoint().id);
-                else emb.trackedMoveOrSwap(neighbours[i], nearest[i]);
-            }
+struct RandomWalk {
+    static void prepare(PSE &, AnnealingState &) { }
+
+    static void refactor(PSE &emb, AnnealingState &state) {
+        int const vertexId = emb.gamma.getRandomVertex(state.distribExp).id;
+
+        // Proposals beyond the drawn bound are rejected without modifying the PSE
+        Point const &point = emb.getRandomPoint();
+        state.propose(vertexId, point.id);
+        if(!emb.boundedMoveOrSwap(vertexId, point.id, state.maxDelta))
+            state.rejected = true;
+    }
+};
+
+struct RebuildNeighbourhood {
+    static void prepare(PSE &, AnnealingState &) { }
+
+    static void refactor(PSE &emb, AnnealingState &state) {
+        Vertex const vertex = emb.gamma.getRandomVertex(state.distribExp);
 
-            return emb;
-        };
+        // Get the nearest points
+        vector<int> &neighbours = ScratchArena::take(ScratchArena::neighbours);
+        vector<int> const &adjacency = emb.gamma.getNeighbours(vertex.id);
+        neighbours.assign(adjacency.begin(), adjacency.end());
+
+        vector<int> &nearest = ScratchArena::take(ScratchArena::nearest);
+        emb.nNearestPoints(vertex.occupiedPoint, vertex.deg, nearest);
+
+        neighbours.push_back(vertex.id);
+        nearest.push_back(vertex.occupiedPoint);
+
+        // Shuffle the nearest points
+        shuffle(nearest.begin(), nearest.end(), threadGenerator());
+
+        // Allow points in a far distance
+        for(size_t i=0; i<neighbours.size(); i++) {
+            int const target = randPercent.pull() < (state.chooseFar * 100) ? emb.getRandomPoint().id : nearest[i];
+            state.propose(neighbours[i], target);
+            emb.trackedMoveOrSwap(neighbours[i], target);
+        }
+    }
+};
 
 // NOT CONSIDERED IN THE THESIS
-inline auto hybrid =
-        [](PSE& emb, vector<double> &runConf){
-            // Execute random walk once the "switch" is triggered
-            if(static_cast<int>(runConf[SimulatedAnnealing::Param::nextMethod]) == 1)
-                return randomWalk(emb, runConf);
-
-            // Trigger "switch" if the last improvement was before two minutes ago
-            double lastImp = runConf[SimulatedAnnealing::Param::lastImp];
-            double tolerance = ceil(120 / runConf[SimulatedAnnealing::Param::loopTime]);
-            runConf[SimulatedAnnealing::Param::nextMethod] = (lastImp < tolerance) ? 0.0 : 1.0;
-
-            // Execute rebuild neighbourhood
-            return rebuildNeighbourhood(emb, runConf);
-        };
+struct Hybrid {
+    static void prepare(PSE &, AnnealingState &) { }
+
+    static void refactor(PSE &emb, AnnealingState &state) {
+        // Execute random walk once the "switch" is triggered
+        if(state.walking) {
+            RandomWalk::refactor(emb, state);
+            return;
+        }
+
+        // Trigger "switch" if the last improvement was before two minutes ago
+        double const tolerance = ceil(120 / state.loopTime);
+        state.walking = static_cast<double>(state.lastImp) >= tolerance;
+
+        // Execute rebuild neighbourhood
+        RebuildNeighbourhood::refactor(emb, state);
+    }
+};
+
+// Random walk to nearby candidates, which suits point sets much larger than the graph
+struct CandidateWalk {
+    static void prepare(PSE &emb, AnnealingState &state) {
+        // Candidates follow the placement every few outer loops
+        if(state.candidates.isEmpty() || ++state.sinceRefresh >= state.refreshLoops) {
+            state.candidates.build(emb, state.cCentroid, state.cNearest);
+            state.sinceRefresh = 0;
+        }
+    }
+
+    static void refactor(PSE &emb, AnnealingState &state) {
+        int const vertexId = emb.gamma.getRandomVertex(state.distribExp).id;
+
+        // Keep global jumps, so vertices can still leave their neighbourhood
+        int pointId = randPercent.pull() < (state.jumpFar * 100) ? -1 : state.candidates.draw(vertexId);
+        if(pointId == -1)
+            pointId = emb.getRandomPoint().id;
+
+        state.propose(vertexId, pointId);
+        if(!emb.boundedMoveOrSwap(vertexId, pointId, state.maxDelta))
+            state.rejected = true;
+    }
+};
+
 #endif